@@ -27,3 +27,6 @@
 // Connect I2C to RDB Header4 Pin6(SDA) and Pin12(SCL)
 #define FT6X06_I2C MT3620_RDB_HEADER4_ISU2_I2C
 
+// Connect INT to RDB Header1 Pin10(GPIO3)
+#define FT6X06_INT MT3620_RDB_HEADER1_PIN10_GPIO
+
@@ -25,6 +25,26 @@ void ft6x06_init(void)
 	if ((buf[1] != FT6206_ID_VALUE) && (buf[1] != FT6x36_ID_VALUE)) {
 		Log_Debug("ERROR: Incorrect FT6X06 detected\r\n");
 	}
+
+	// keep INT asserted for as long as the panel is touched
+	buf[0] = FT6206_GMODE_REG;
+	buf[1] = FT6206_GMODE_POLLING;
+
+	(void)ft6x06_ll_i2c_tx(&buf[0], 2);
+
+	(void)ft6x06_ll_int_init();
+}
+
+static void ft6x06_convert_xy(const uint8_t* p_buf, uint16_t* p_x, uint16_t* p_y)
+{
+	*p_x = ((p_buf[0] & FT6206_MSB_MASK) << 8) | (p_buf[1] & FT6206_LSB_MASK);
+	*p_y = ((p_buf[2] & FT6206_MSB_MASK) << 8) | (p_buf[3] & FT6206_LSB_MASK);
+
+#if (ORITENTATION == LANDSCAPE)
+	uint16_t tmpt = ILI9341_LCD_PIXEL_WIDTH - *p_y - 1;
+	*p_y = *p_x;
+	*p_x = tmpt;
+#endif
 }
 
 uint8_t ft6x06_detect_touch(void)
@@ -51,14 +71,31 @@ void ft6x06_get_xy(uint16_t *p_x, uint16_t *p_y)
 
 	ft6x06_ll_i2c_tx_then_rx(&reg, 1, &buf[0], 4);
 
-	*p_x = ((buf[0] & FT6206_MSB_MASK) << 8) | (buf[1] & FT6206_LSB_MASK);
-	*p_y = ((buf[2] & FT6206_MSB_MASK) << 8) | (buf[3] & FT6206_LSB_MASK);
+	ft6x06_convert_xy(&buf[0], p_x, p_y);
+}
 
-#if (ORITENTATION == LANDSCAPE)
-	uint16_t tmpt = ILI9341_LCD_PIXEL_WIDTH - *p_y - 1;
-	*p_y = *p_x;
-	*p_x = tmpt;
-#endif
+uint8_t ft6x06_read_touch(uint16_t* p_x, uint16_t* p_y)
+{
+	// TD_STAT and P1_XH..P1_YL are adjacent, one transaction gets all of them
+	uint8_t reg = FT6206_TD_STAT_REG;
+	uint8_t buf[1 + FT6206_P1_YL_REG - FT6206_P1_XH_REG + 1];
+
+	if (!ft6x06_ll_int_asserted()) {
+		return 0;
+	}
+
+	if (ft6x06_ll_i2c_tx_then_rx(&reg, 1, &buf[0], sizeof(buf)) < 0) {
+		return 0;
+	}
+
+	uint8_t touches = buf[0] & FT6206_TD_STAT_MASK;
+
+	// after reset, the device report 15
+	if ((touches == 0) || (touches > FT6206_MAX_DETECTABLE_TOUCH)) {
+		return 0;
+	}
+
+	ft6x06_convert_xy(&buf[1], p_x, p_y);
 
-	Log_Debug("%d, %d\r\n", *p_x, *p_y);
+	return touches;
 }
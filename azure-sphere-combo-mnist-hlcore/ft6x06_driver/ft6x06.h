@@ -48,6 +48,11 @@
 #define FT6206_TOUCH_AREA_SHIFT         0x04
 
 #define FT6206_PERIODACTIVE_REG         0x88
+
+#define FT6206_GMODE_REG                0xA4
+
+#define FT6206_GMODE_POLLING            0x00	// INT held low while touched
+#define FT6206_GMODE_TRIGGER            0x01	// INT pulses for every report
 #define FT6206_CHIP_ID_REG              0xA8
 
 #define FT6206_ID_VALUE                 0x11
@@ -56,6 +61,7 @@
 void ft6x06_init(void);
 uint8_t ft6x06_detect_touch(void);
 void ft6x06_get_xy(uint16_t* p_x, uint16_t* p_y);
+uint8_t ft6x06_read_touch(uint16_t* p_x, uint16_t* p_y);
 
 #endif
 
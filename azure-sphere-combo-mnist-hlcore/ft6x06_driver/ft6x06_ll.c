@@ -8,10 +8,12 @@
 #include <applibs/log.h>
 #include "applibs_versions.h"
 #include <applibs/i2c.h>
+#include <applibs/gpio.h>
 
 #include <hw/sample_hardware.h>
 
 static int i2cFd;
+static int intGpioFd = -1;
 
 #elif defined(AzureSphere_CM4)
 
@@ -64,6 +66,52 @@ int ft6x06_ll_i2c_init(void)
 #endif
 }
 
+int ft6x06_ll_int_init(void)
+{
+#if defined(AzureSphere_CA7)
+
+#if defined(FT6X06_INT)
+	intGpioFd = GPIO_OpenAsInput(FT6X06_INT);
+	if (intGpioFd < 0) {
+		Log_Debug("ERROR: GPIO_OpenAsInput: errno=%d (%s)\r\n", errno, strerror(errno));
+		return -1;
+	}
+#endif
+
+	return 0;
+
+#elif defined(AzureSphere_CM4)
+
+	// removed
+
+#endif
+}
+
+bool ft6x06_ll_int_asserted(void)
+{
+#if defined(AzureSphere_CA7)
+
+	GPIO_Value_Type value;
+
+	// without INT wired up, always go to the device
+	if (intGpioFd < 0) {
+		return true;
+	}
+
+	if (GPIO_GetValue(intGpioFd, &value) < 0) {
+		return true;
+	}
+
+	// INT is active low and held while a touch is present
+	return (value == GPIO_Value_Low);
+
+#elif defined(AzureSphere_CM4)
+
+	// removed
+
+#endif
+}
+
 int ft6x06_ll_i2c_tx(uint8_t* tx_data, uint32_t tx_len)
 {
 #if defined(AzureSphere_CA7)
@@ -2,9 +2,12 @@
 #define FT6X06_LL_H
 
 #include <stdint.h>
+#include <stdbool.h>
 
 int ft6x06_ll_i2c_init(void);
 int ft6x06_ll_i2c_tx(uint8_t* tx_data, uint32_t tx_len);
 int ft6x06_ll_i2c_tx_then_rx(uint8_t* tx_data, uint32_t tx_len, uint8_t* rx_data, uint32_t rx_len);
+int ft6x06_ll_int_init(void);
+bool ft6x06_ll_int_asserted(void);
 
 #endif
\ No newline at end of file
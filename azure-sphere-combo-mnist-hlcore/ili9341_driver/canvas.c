@@ -0,0 +1,166 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "ili9341.h"
+#include "ili9341_ll.h"
+#include "canvas.h"
+
+// Rows of the dirty area are packed here so the flush goes out in large transfers
+#define STAGING_SIZE		4096
+
+// Pixels are kept in LCD byte order (big endian) so they can be copied out as they are
+static uint16_t s_pixels[CANVAS_WIDTH * CANVAS_HEIGHT];
+static uint8_t s_staging[STAGING_SIZE];
+
+static uint16_t s_originX, s_originY;
+
+static bool s_dirty;
+static int16_t s_dirtyX0, s_dirtyY0, s_dirtyX1, s_dirtyY1;
+
+static uint16_t _to_lcd_order(uint16_t color)
+{
+	return (uint16_t)((color >> 8) | (color << 8));
+}
+
+static void _mark_dirty(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+	if (!s_dirty) {
+		s_dirtyX0 = x0;
+		s_dirtyY0 = y0;
+		s_dirtyX1 = x1;
+		s_dirtyY1 = y1;
+		s_dirty = true;
+		return;
+	}
+
+	if (x0 < s_dirtyX0) s_dirtyX0 = x0;
+	if (y0 < s_dirtyY0) s_dirtyY0 = y0;
+	if (x1 > s_dirtyX1) s_dirtyX1 = x1;
+	if (y1 > s_dirtyY1) s_dirtyY1 = y1;
+}
+
+static void _fill_span(int16_t x0, int16_t x1, int16_t y, uint16_t pixel)
+{
+	uint16_t* p = &s_pixels[y * CANVAS_WIDTH];
+
+	for (int16_t x = x0; x <= x1; x++) {
+		p[x] = pixel;
+	}
+}
+
+void canvas_init(uint16_t x0, uint16_t y0, uint16_t color)
+{
+	s_originX = x0;
+	s_originY = y0;
+
+	canvas_clear(color);
+}
+
+void canvas_clear(uint16_t color)
+{
+	uint16_t pixel = _to_lcd_order(color);
+
+	for (uint32_t i = 0; i < CANVAS_WIDTH * CANVAS_HEIGHT; i++) {
+		s_pixels[i] = pixel;
+	}
+
+	_mark_dirty(0, 0, CANVAS_WIDTH - 1, CANVAS_HEIGHT - 1);
+}
+
+void canvas_fill_rect(int16_t x0, int16_t y0, int16_t width, int16_t height, uint16_t color)
+{
+	int16_t x1 = x0 + width - 1;
+	int16_t y1 = y0 + height - 1;
+
+	// clip to canvas
+	if (x0 < 0) x0 = 0;
+	if (y0 < 0) y0 = 0;
+	if (x1 > CANVAS_WIDTH - 1) x1 = CANVAS_WIDTH - 1;
+	if (y1 > CANVAS_HEIGHT - 1) y1 = CANVAS_HEIGHT - 1;
+
+	if ((x0 > x1) || (y0 > y1)) {
+		return;
+	}
+
+	uint16_t pixel = _to_lcd_order(color);
+
+	for (int16_t y = y0; y <= y1; y++) {
+		_fill_span(x0, x1, y, pixel);
+	}
+
+	_mark_dirty(x0, y0, x1, y1);
+}
+
+void canvas_fill_circle(int16_t x0, int16_t y0, uint16_t r, uint16_t color)
+{
+	uint16_t pixel = _to_lcd_order(color);
+	int32_t rr = (int32_t)r * r;
+	int16_t half = 0;
+
+	if ((x0 + r < 0) || (y0 + r < 0) || (x0 - r > CANVAS_WIDTH - 1) || (y0 - r > CANVAS_HEIGHT - 1)) {
+		return;
+	}
+
+	for (int16_t dy = -(int16_t)r; dy <= (int16_t)r; dy++) {
+		int16_t y = y0 + dy;
+		if ((y < 0) || (y > CANVAS_HEIGHT - 1)) {
+			continue;
+		}
+
+		// widest half span with dx^2 + dy^2 <= r^2, grows then shrinks from the previous row
+		while ((int32_t)(half + 1) * (half + 1) + (int32_t)dy * dy <= rr) {
+			half++;
+		}
+		while ((half > 0) && ((int32_t)half * half + (int32_t)dy * dy > rr)) {
+			half--;
+		}
+
+		int16_t xs = x0 - half;
+		int16_t xe = x0 + half;
+		if (xs < 0) xs = 0;
+		if (xe > CANVAS_WIDTH - 1) xe = CANVAS_WIDTH - 1;
+
+		if (xs <= xe) {
+			_fill_span(xs, xe, y, pixel);
+		}
+	}
+
+	_mark_dirty((x0 - r < 0) ? 0 : x0 - r,
+		(y0 - r < 0) ? 0 : y0 - r,
+		(x0 + r > CANVAS_WIDTH - 1) ? CANVAS_WIDTH - 1 : x0 + r,
+		(y0 + r > CANVAS_HEIGHT - 1) ? CANVAS_HEIGHT - 1 : y0 + r);
+}
+
+int canvas_flush(void)
+{
+	if (!s_dirty) {
+		return 0;
+	}
+
+	uint16_t width = (uint16_t)(s_dirtyX1 - s_dirtyX0 + 1);
+	uint16_t height = (uint16_t)(s_dirtyY1 - s_dirtyY0 + 1);
+	uint32_t rowBytes = width * 2;
+	uint32_t used = 0;
+
+	ili9341_set_window(s_originX + s_dirtyX0, s_originY + s_dirtyY0,
+		s_originX + s_dirtyX1, s_originY + s_dirtyY1);
+	ili9341_ll_dc_high();
+
+	s_dirty = false;
+
+	for (uint16_t row = 0; row < height; row++) {
+
+		if (used + rowBytes > STAGING_SIZE) {
+			if (ili9341_ll_spi_tx(&s_staging[0], used) < 0) {
+				return -1;
+			}
+			used = 0;
+		}
+
+		memcpy(&s_staging[used], &s_pixels[(s_dirtyY0 + row) * CANVAS_WIDTH + s_dirtyX0], rowBytes);
+		used += rowBytes;
+	}
+
+	return ili9341_ll_spi_tx(&s_staging[0], used);
+}
@@ -0,0 +1,17 @@
+#ifndef __CANVAS_H
+#define __CANVAS_H
+
+#include <stdint.h>
+
+// RGB565 shadow of a screen region, drawing goes to RAM and canvas_flush() sends
+// the dirty part to the LCD in a single window
+#define CANVAS_WIDTH		168
+#define CANVAS_HEIGHT		168
+
+void canvas_init(uint16_t x0, uint16_t y0, uint16_t color);
+void canvas_clear(uint16_t color);
+void canvas_fill_rect(int16_t x0, int16_t y0, int16_t width, int16_t height, uint16_t color);
+void canvas_fill_circle(int16_t x0, int16_t y0, uint16_t r, uint16_t color);
+int  canvas_flush(void);
+
+#endif /* __CANVAS_H */
@@ -1,3 +1,5 @@
+#include <stddef.h>
+
 #include "ili9341_ll.h"
 #include "ili9341.h"
 #include "delay.h"
@@ -53,19 +55,12 @@ void ili9341_reset(void)
 
 void ili9341_set_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
 {
-	ili9341_write_cmd(LCD_COLUMN_ADDR);
-	ili9341_write_cmd_param(x0 >> 8);
-	ili9341_write_cmd_param(x0);
-	ili9341_write_cmd_param(x1 >> 8);
-	ili9341_write_cmd_param(x1);
-
-	ili9341_write_cmd(LCD_PAGE_ADDR);
-	ili9341_write_cmd_param(y0 >> 8);
-	ili9341_write_cmd_param(y0);
-	ili9341_write_cmd_param(y1 >> 8);
-	ili9341_write_cmd_param(y1);
-
-	ili9341_write_cmd(LCD_GRAM);
+	uint8_t column[4] = { x0 >> 8, x0, x1 >> 8, x1 };
+	uint8_t page[4] = { y0 >> 8, y0, y1 >> 8, y1 };
+
+	(void)ili9341_ll_write_cmd(LCD_COLUMN_ADDR, &column[0], sizeof(column));
+	(void)ili9341_ll_write_cmd(LCD_PAGE_ADDR, &page[0], sizeof(page));
+	(void)ili9341_ll_write_cmd(LCD_GRAM, NULL, 0);
 }
 
 void ili9341_draw_pixel(uint16_t x, uint16_t y, uint16_t color) 
@@ -91,9 +86,7 @@ void ili9341_fill_rect(uint16_t x0, uint16_t y0, uint16_t width, uint16_t height
 	ili9341_set_window(x0, y0, (x0 + width - 1), (y0 + height - 1));
 
 	ili9341_ll_dc_high();
-	for (uint32_t i = 0; i < total_pixel; i++) {
-		ili9341_ll_spi_tx_u16(color);
-	}
+	(void)ili9341_ll_spi_fill_u16(color, total_pixel);
 }
 
 void ili9341_clean_screen(uint16_t color)
@@ -174,113 +167,40 @@ void ili9341_fillCircle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color) {
 }
 
 
+// Power up sequence, { cmd, number of params, params... }
+static const uint8_t initCmdList[] = {
+	0xCB, 5, 0x39, 0x2C, 0x00, 0x34, 0x02,
+	0xCF, 3, 0x00, 0xC1, 0x30,
+	0xE8, 3, 0x85, 0x00, 0x78,
+	0xEA, 2, 0x00, 0x00,
+	0xED, 4, 0x64, 0x03, 0x12, 0x81,
+	0xF7, 1, 0x20,
+	0xC0, 1, 0x23,	// Power control
+	0xC1, 1, 0x10,	// Power control
+	0xC5, 2, 0x3e, 0x28,	// VCM control
+	0xC7, 1, 0x86,
+#if (ORITENTATION == VERTICAL)
+	0x36, 1, 0x48,
+#elif (ORITENTATION == LANDSCAPE)
+	0x36, 1, 0x28,
+#endif
+	0x3A, 1, 0x55,
+	0xB1, 2, 0x00, 0x18,
+	0xB6, 3, 0x08, 0x82, 0x27,	// Display Function Control
+	0xF2, 1, 0x00,	// 3Gamma Function Disable
+	0x26, 1, 0x01,	// Gamma curve selected
+	0xE0, 15, 0x0F, 0x31, 0x2B, 0x0C, 0x0E, 0x08, 0x4E, 0xF1, 0x37, 0x07, 0x10, 0x03, 0x0E, 0x09, 0x00,	// Set Gamma
+	0xE1, 15, 0x00, 0x0E, 0x14, 0x03, 0x11, 0x07, 0x31, 0xC1, 0x48, 0x08, 0x0F, 0x0C, 0x31, 0x36, 0x0F,	// Set Gamma
+	0x00, ILI9341_LL_CMD_LIST_END
+};
+
 void ili9341_init(void)
 {
 	ili9341_ll_init();
 
 	ili9341_reset();
 
-	ili9341_write_cmd(0xCB);
-	ili9341_write_cmd_param(0x39);
-	ili9341_write_cmd_param(0x2C);
-	ili9341_write_cmd_param(0x00);
-	ili9341_write_cmd_param(0x34);
-	ili9341_write_cmd_param(0x02);
-
-	ili9341_write_cmd(0xCF);
-	ili9341_write_cmd_param(0x00);
-	ili9341_write_cmd_param(0XC1);
-	ili9341_write_cmd_param(0X30);
-
-	ili9341_write_cmd(0xE8);
-	ili9341_write_cmd_param(0x85);
-	ili9341_write_cmd_param(0x00);
-	ili9341_write_cmd_param(0x78);
-
-	ili9341_write_cmd(0xEA);
-	ili9341_write_cmd_param(0x00);
-	ili9341_write_cmd_param(0x00);
-
-	ili9341_write_cmd(0xED);
-	ili9341_write_cmd_param(0x64);
-	ili9341_write_cmd_param(0x03);
-	ili9341_write_cmd_param(0X12);
-	ili9341_write_cmd_param(0X81);
-
-	ili9341_write_cmd(0xF7);
-	ili9341_write_cmd_param(0x20);
-
-	ili9341_write_cmd(0xC0);    	//Power control 
-	ili9341_write_cmd_param(0x23);   	//VRH[5:0] 
-
-	ili9341_write_cmd(0xC1);    	//Power control 
-	ili9341_write_cmd_param(0x10);   	//SAP[2:0];BT[3:0] 
-
-	ili9341_write_cmd(0xC5);    	//VCM control 
-	ili9341_write_cmd_param(0x3e);   	//Contrast
-	ili9341_write_cmd_param(0x28);
-
-	ili9341_write_cmd(0xC7);
-	ili9341_write_cmd_param(0x86);  	    //--
-
-	ili9341_write_cmd(0x36);
-#if (ORITENTATION == VERTICAL)
-	ili9341_write_cmd_param(0x48);
-#elif (ORITENTATION == LANDSCAPE)
-	ili9341_write_cmd_param(0x28);
-#endif
-
-	ili9341_write_cmd(0x3A);
-	ili9341_write_cmd_param(0x55);
-
-	ili9341_write_cmd(0xB1);
-	ili9341_write_cmd_param(0x00);
-	ili9341_write_cmd_param(0x18);
-
-	ili9341_write_cmd(0xB6);    	// Display Function Control 
-	ili9341_write_cmd_param(0x08);
-	ili9341_write_cmd_param(0x82);
-	ili9341_write_cmd_param(0x27);
-
-	ili9341_write_cmd(0xF2);    	// 3Gamma Function Disable 
-	ili9341_write_cmd_param(0x00);
-
-	ili9341_write_cmd(0x26);    	//Gamma curve selected 
-	ili9341_write_cmd_param(0x01);
-
-	ili9341_write_cmd(0xE0);    	//Set Gamma 
-	ili9341_write_cmd_param(0x0F);
-	ili9341_write_cmd_param(0x31);
-	ili9341_write_cmd_param(0x2B);
-	ili9341_write_cmd_param(0x0C);
-	ili9341_write_cmd_param(0x0E);
-	ili9341_write_cmd_param(0x08);
-	ili9341_write_cmd_param(0x4E);
-	ili9341_write_cmd_param(0xF1);
-	ili9341_write_cmd_param(0x37);
-	ili9341_write_cmd_param(0x07);
-	ili9341_write_cmd_param(0x10);
-	ili9341_write_cmd_param(0x03);
-	ili9341_write_cmd_param(0x0E);
-	ili9341_write_cmd_param(0x09);
-	ili9341_write_cmd_param(0x00);
-
-	ili9341_write_cmd(0XE1);    	//Set Gamma 
-	ili9341_write_cmd_param(0x00);
-	ili9341_write_cmd_param(0x0E);
-	ili9341_write_cmd_param(0x14);
-	ili9341_write_cmd_param(0x03);
-	ili9341_write_cmd_param(0x11);
-	ili9341_write_cmd_param(0x07);
-	ili9341_write_cmd_param(0x31);
-	ili9341_write_cmd_param(0xC1);
-	ili9341_write_cmd_param(0x48);
-	ili9341_write_cmd_param(0x08);
-	ili9341_write_cmd_param(0x0F);
-	ili9341_write_cmd_param(0x0C);
-	ili9341_write_cmd_param(0x31);
-	ili9341_write_cmd_param(0x36);
-	ili9341_write_cmd_param(0x0F);
+	(void)ili9341_ll_write_cmd_list(&initCmdList[0]);
 
 	ili9341_write_cmd(0x11);    	//Exit Sleep 
 	delay_ms(120);
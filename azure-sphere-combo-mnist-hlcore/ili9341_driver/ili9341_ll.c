@@ -21,6 +21,14 @@ static int spiFd;
 
 #define MAX_SPI_TRANSFER_BYTES	4096
 
+// Pixels are replicated into this buffer so a fill goes out in MAX_SPI_TRANSFER_BYTES chunks
+static uint8_t lineBuffer[MAX_SPI_TRANSFER_BYTES];
+static uint16_t lineBufferColor;
+static uint32_t lineBufferFilled;
+
+// Last level driven on DC, GPIO_SetValue is skipped when it does not change
+static int dcState = -1;
+
 #elif defined(AzureSphere_CM4)
 
 // removed
@@ -58,7 +66,10 @@ void ili9341_ll_dc_low(void)
 {
 #if defined(AzureSphere_CA7)
 
-	GPIO_SetValue(DcGpioFd, GPIO_Value_Low);
+	if (dcState != GPIO_Value_Low) {
+		GPIO_SetValue(DcGpioFd, GPIO_Value_Low);
+		dcState = GPIO_Value_Low;
+	}
 
 #elif defined(AzureSphere_CM4)
 
@@ -71,7 +82,10 @@ void ili9341_ll_dc_high(void)
 {
 #if defined(AzureSphere_CA7)
 
-	GPIO_SetValue(DcGpioFd, GPIO_Value_High);
+	if (dcState != GPIO_Value_High) {
+		GPIO_SetValue(DcGpioFd, GPIO_Value_High);
+		dcState = GPIO_Value_High;
+	}
 
 #elif defined(AzureSphere_CM4)
 
@@ -121,6 +135,7 @@ int ili9341_ll_init(void)
 		Log_Debug("ERROR: GPIO_OpenAsOutput: errno=%d (%s)\n", errno, strerror(errno));
 		return -1;
 	}
+	dcState = GPIO_Value_High;
 
 	BlGpioFd = GPIO_OpenAsOutput(ILI9341_BL, GPIO_OutputMode_PushPull, GPIO_Value_Low);
 	if (BlGpioFd < 0) {
@@ -317,3 +332,74 @@ int ili9341_ll_spi_tx(uint8_t *p_data, uint32_t tx_len)
 #endif
 }
 
+int ili9341_ll_spi_fill_u16(uint16_t data, uint32_t count)
+{
+#if defined(AzureSphere_CA7)
+
+	uint32_t bytes = count * 2;
+	uint32_t fill = (bytes < MAX_SPI_TRANSFER_BYTES) ? bytes : MAX_SPI_TRANSFER_BYTES;
+
+	// Only (re)build the part of the line buffer which is not already holding this color
+	if (lineBufferColor != data) {
+		lineBufferColor = data;
+		lineBufferFilled = 0;
+	}
+
+	for (uint32_t i = lineBufferFilled; i < fill; i += 2) {
+		lineBuffer[i] = data >> 8;
+		lineBuffer[i + 1] = data;
+	}
+
+	if (fill > lineBufferFilled) {
+		lineBufferFilled = fill;
+	}
+
+	while (bytes > 0) {
+		uint32_t len = (bytes < MAX_SPI_TRANSFER_BYTES) ? bytes : MAX_SPI_TRANSFER_BYTES;
+
+		if (ili9341_ll_spi_tx(&lineBuffer[0], len) < 0) {
+			return -1;
+		}
+
+		bytes -= len;
+	}
+
+	return 0;
+
+#elif defined(AzureSphere_CM4)
+
+	// removed
+
+#endif
+}
+
+int ili9341_ll_write_cmd(uint8_t cmd, const uint8_t* p_params, uint32_t len)
+{
+	ili9341_ll_dc_low();
+	if (ili9341_ll_spi_tx_u8(cmd) < 0) {
+		return -1;
+	}
+
+	if (len == 0) {
+		return 0;
+	}
+
+	// All parameters of one command go out in one transfer
+	ili9341_ll_dc_high();
+	return ili9341_ll_spi_tx((uint8_t*)p_params, len);
+}
+
+int ili9341_ll_write_cmd_list(const uint8_t* p_list)
+{
+	// { cmd, number of params, params... } repeated, closed by ILI9341_LL_CMD_LIST_END
+	while (p_list[1] != ILI9341_LL_CMD_LIST_END) {
+
+		if (ili9341_ll_write_cmd(p_list[0], &p_list[2], p_list[1]) < 0) {
+			return -1;
+		}
+
+		p_list += 2 + p_list[1];
+	}
+
+	return 0;
+}
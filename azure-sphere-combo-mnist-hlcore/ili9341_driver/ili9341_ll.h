@@ -18,4 +18,14 @@ int ili9341_ll_spi_tx_u8(uint8_t data);
 int ili9341_ll_spi_rx_u8(uint8_t* data);
 int ili9341_ll_spi_tx_u16(uint16_t data);
 int ili9341_ll_spi_tx(uint8_t* p_data, uint32_t len);
+
+// Send the same 16bit value count times using multi-KB transfers
+int ili9341_ll_spi_fill_u16(uint16_t data, uint32_t count);
+
+// Send a command and its parameters, two transfers at most
+int ili9341_ll_write_cmd(uint8_t cmd, const uint8_t* p_params, uint32_t len);
+
+// Send a list of { cmd, number of params, params... } entries ended by ILI9341_LL_CMD_LIST_END
+#define ILI9341_LL_CMD_LIST_END		0xFF
+int ili9341_ll_write_cmd_list(const uint8_t* p_list);
 #endif /* __ILI9341_LL_H */
@@ -0,0 +1,188 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+#include <applibs/log.h>
+
+#include "nnom.h"
+#include "weights.h"
+#include "local_nn.h"
+
+typedef enum {
+	LOCAL_IDLE,
+	LOCAL_BUSY,		// s_req belongs to the worker
+	LOCAL_DONE,		// s_result is waiting to be taken
+} LocalState_t;
+
+static pthread_t s_thread;
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_cond = PTHREAD_COND_INITIALIZER;
+static LocalState_t s_state = LOCAL_IDLE;
+static bool s_stop;
+static bool s_started;
+static int s_eventFd = -1;
+
+static nnom_model_t* s_model;
+static IntercoreClassifyReq_t s_req;
+static IntercoreClassifyResult_t s_result;
+static uint32_t s_latencyUs;
+
+// same steps and result fields as the RT app
+static void _classify(void)
+{
+	uint32_t topk[INTERCORE_TOPK];
+	uint32_t confidence;
+	uint32_t time = nnom_us_get();
+
+	memcpy(nnom_input_data, s_req.image, sizeof(nnom_input_data));
+	(void)model_run(s_model);
+	nnom_topk_q7(nnom_output_data, INTERCORE_CLASSES, topk, INTERCORE_TOPK, &confidence);
+
+	memset(&s_result, 0, sizeof(s_result));
+	s_result.type = MSG_CLASSIFY_RESULT;
+	s_result.seq = s_req.seq;
+	s_result.label = (uint8_t)topk[0];
+	s_result.flags = (s_req.flags & REQ_FLAG_SPECULATIVE) ? RESULT_FLAG_SPECULATIVE : 0;
+	s_result.confidence = (uint8_t)confidence;
+	memcpy(s_result.probs, nnom_output_data, sizeof(s_result.probs));
+	for (int i = 0; i < INTERCORE_TOPK; i++) {
+		s_result.topk[i] = (uint8_t)topk[i];
+	}
+
+	time = nnom_us_get() - time;
+	pthread_mutex_lock(&s_lock);
+	s_latencyUs = (s_latencyUs == 0) ? time : (3 * s_latencyUs + time) / 4;
+	pthread_mutex_unlock(&s_lock);
+}
+
+static void* _worker(void* p_arg)
+{
+	uint64_t one = 1;
+
+	pthread_mutex_lock(&s_lock);
+	while (1) {
+		while ((s_state != LOCAL_BUSY) && !s_stop) {
+			pthread_cond_wait(&s_cond, &s_lock);
+		}
+		if (s_stop) {
+			break;
+		}
+
+		pthread_mutex_unlock(&s_lock);
+		_classify();
+		pthread_mutex_lock(&s_lock);
+
+		s_state = LOCAL_DONE;
+		if (write(s_eventFd, &one, sizeof(one)) != sizeof(one)) {
+			Log_Debug("ERROR: local_nn could not signal a result: %d (%s)\r\n", errno, strerror(errno));
+		}
+	}
+	pthread_mutex_unlock(&s_lock);
+
+	return NULL;
+}
+
+int local_nn_init(void)
+{
+	s_model = nnom_model_create();
+	if (s_model == NULL) {
+		return -1;
+	}
+
+	// one run on an empty image, so the first routing decision has a latency to go by
+	memset(&s_req, 0, sizeof(s_req));
+	_classify();
+	Log_Debug("local_nn: %d us per inference\r\n", s_latencyUs);
+
+	s_eventFd = eventfd(0, EFD_NONBLOCK);
+	if (s_eventFd == -1) {
+		Log_Debug("ERROR: local_nn eventfd: %d (%s)\r\n", errno, strerror(errno));
+		return -1;
+	}
+
+	if (pthread_create(&s_thread, NULL, _worker, NULL) != 0) {
+		Log_Debug("ERROR: local_nn could not start the worker\r\n");
+		return -1;
+	}
+	s_started = true;
+
+	return s_eventFd;
+}
+
+void local_nn_close(void)
+{
+	if (s_started) {
+		pthread_mutex_lock(&s_lock);
+		s_stop = true;
+		pthread_cond_signal(&s_cond);
+		pthread_mutex_unlock(&s_lock);
+		pthread_join(s_thread, NULL);
+		s_started = false;
+	}
+
+	if (s_eventFd >= 0) {
+		close(s_eventFd);
+		s_eventFd = -1;
+	}
+}
+
+bool local_nn_idle(void)
+{
+	bool idle;
+
+	pthread_mutex_lock(&s_lock);
+	idle = s_started && (s_state == LOCAL_IDLE);
+	pthread_mutex_unlock(&s_lock);
+
+	return idle;
+}
+
+int local_nn_submit(const IntercoreClassifyReq_t* p_req)
+{
+	int ret = -1;
+
+	pthread_mutex_lock(&s_lock);
+	if (s_started && (s_state == LOCAL_IDLE)) {
+		memcpy(&s_req, p_req, sizeof(s_req));
+		s_state = LOCAL_BUSY;
+		pthread_cond_signal(&s_cond);
+		ret = 0;
+	}
+	pthread_mutex_unlock(&s_lock);
+
+	return ret;
+}
+
+int local_nn_result(IntercoreClassifyResult_t* p_result)
+{
+	uint64_t count;
+	int ret = -1;
+
+	// clears the event, nothing to read is fine
+	(void)read(s_eventFd, &count, sizeof(count));
+
+	pthread_mutex_lock(&s_lock);
+	if (s_state == LOCAL_DONE) {
+		memcpy(p_result, &s_result, sizeof(s_result));
+		s_state = LOCAL_IDLE;
+		ret = 0;
+	}
+	pthread_mutex_unlock(&s_lock);
+
+	return ret;
+}
+
+uint32_t local_nn_latency_us(void)
+{
+	uint32_t us;
+
+	pthread_mutex_lock(&s_lock);
+	us = s_latencyUs;
+	pthread_mutex_unlock(&s_lock);
+
+	return us;
+}
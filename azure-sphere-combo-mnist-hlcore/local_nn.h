@@ -0,0 +1,28 @@
+#ifndef __LOCAL_NN_H
+#define __LOCAL_NN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "intercore_msg.h"
+
+// Runs the RT app's model on this core in a worker thread, for when the RT core is busy or
+// not answering. Requests and results are in the intercore format and results are the same
+// as the RT app's, bit for bit. One request at a time.
+
+// returns a file descriptor which is readable while a result is ready, -1 on failure
+int local_nn_init(void);
+void local_nn_close(void);
+
+bool local_nn_idle(void);
+
+// the image is copied, returns -1 if a request is still running
+int local_nn_submit(const IntercoreClassifyReq_t* p_req);
+
+// returns -1 if there is no result, the worker is idle again after a result is taken
+int local_nn_result(IntercoreClassifyResult_t* p_result);
+
+// average time of an inference on this core
+uint32_t local_nn_latency_us(void);
+
+#endif
@@ -15,7 +15,12 @@
 #include "delay.h"
 #include "ili9341.h"
 #include "text.h"
+#include "canvas.h"
+#include "stroke.h"
+#include "preprocess.h"
 #include "ft6x06.h"
+#include "intercore_msg.h"
+#include "local_nn.h"
 
 typedef enum {
 	SM_IDLE,
@@ -34,25 +39,77 @@ typedef enum {
 #define SQ_RIGHTDOWN_X	((ILI9341_LCD_PIXEL_WIDTH - SQ_SIDE) / 2 + SQ_SIDE)
 #define SQ_RIGHTDOWN_Y	((ILI9341_LCD_PIXEL_HEIGHT - SQ_SIDE) / 2 + SQ_SIDE)
 #define R				10
-#define MINST_BUF_SIZE	784	// 28 * 28
 
 #define BUTTON_R		25
 
-#define ACTIVE_AREA_SIZE	(SQ_SIDE * SQ_SIDE * 2)
+// Uncomment to log LCD fill throughput at start up
+// #define LCD_BENCHMARK
+#define LCD_BENCHMARK_FILLS	20
+
+// Uncomment when the RT apps run as the two stage pipeline (PIPELINE_STAGE 1 and 2). Requests
+// and credits stay with the front stage, its activations are relayed to the back stage which
+// sends the results
+// #define RT_PIPELINE
 
 static uint8_t frameBuffer[SQ_SIDE * SQ_SIDE];
-const static uint8_t cleanBitmap[ACTIVE_AREA_SIZE] = { [0 ... (ACTIVE_AREA_SIZE - 1)] = 0xFF };
-static uint8_t mnistBuffer[MINST_BUF_SIZE];
+static uint16_t cellBuffer[(SQ_SIDE / STROKE_CELL) * (SQ_SIDE / STROKE_CELL)];
+static IntercoreClassifyReq_t request = { .type = MSG_CLASSIFY_REQ };
+
+// Flow control towards RT core, a request is only sent when RT core has a credit for it
+#define RESPONSE_TO		50 // 50 x 20 = 1s
+static uint8_t rtCredits = INTERCORE_INITIAL_CREDITS;
+static uint8_t outstanding;
+static bool requestPending;
+static uint32_t response_count;
+static uint32_t sendDropped;
+static uint32_t sendDeferred;
+
+// Final requests run on this core instead when the RT core would answer later than the local
+// worker, judged by the requests it still holds and its recent round trip time
+static bool rtStalled;			// no answer within RESPONSE_TO, cleared by the next one
+static uint32_t rtLatencyUs;	// average round trip, 0 until the first result
+static uint32_t sentUs[256];	// send time per request seq
+static uint32_t localCount;
+
+// A final result below this confidence (percent) is shown as '?' rather than a digit
+#define CONFIDENCE_MIN	40
+
+// While drawing, a snapshot of the digit is classified every SNAPSHOT_TO ticks so a guess
+// is on screen before the pen is lifted. Snapshots only use spare credits, never queue.
+#define SNAPSHOT_TO		10 // 10 x 20 = 200ms
+static uint32_t snapshot_count;
+static bool snapshotInk;
+
+static WorkStateMachine_t workState = SM_IDLE;
+
+// Strongest touch result seen by TouchEventHandler since the last state machine tick
+static uint8_t touchSeen = NO_TOUCH;
 
 static void SocketEventHandler(EventData* eventData);
+#if defined(RT_PIPELINE)
+static void BackSocketEventHandler(EventData* eventData);
+#endif
 static void TimerEventHandler(EventData* eventData);
+static void TouchEventHandler(EventData* eventData);
+static void LocalResultEventHandler(EventData* eventData);
 static const char rtAppComponentId[] = "8903cf17-d461-4d72-8293-0b7c5a56222b";
 static int timerFd = 0;
+static int touchTimerFd = 0;
 static int epollFd = 0;
 static int rtSocketFd = 0;
+static int localFd = -1;
+#if defined(RT_PIPELINE)
+static const char rtBackAppComponentId[] = "c409b412-7f68-459e-bff5-1fa2984113fa";
+static int rtBackSocketFd = 0;
+#endif
 
 static EventData timerEventData = { .eventHandler = &TimerEventHandler };
 static EventData socketEventData = { .eventHandler = &SocketEventHandler };
+#if defined(RT_PIPELINE)
+static EventData backSocketEventData = { .eventHandler = &BackSocketEventHandler };
+#endif
+static EventData touchEventData = { .eventHandler = &TouchEventHandler };
+static EventData localEventData = { .eventHandler = &LocalResultEventHandler };
 
 // Termination state
 static volatile sig_atomic_t terminationRequired = false;
@@ -65,56 +122,158 @@ static void TerminationHandler(int signalNumber)
 
 static uint8_t checkTouchAndDrawPoint(void)
 {
-	uint16_t x, y, _x_, _y_;
+	uint16_t x, y;
 
-	if (ft6x06_detect_touch() > 0) {
-		ft6x06_get_xy(&x, &y);
+	if (ft6x06_read_touch(&x, &y) > 0) {
 
 		if ((x - R > SQ_LEFTUP_X) && (x + R < SQ_RIGHTDOWN_X) && (y - R > SQ_LEFTUP_Y) && (y + R < SQ_RIGHTDOWN_Y)) {
 
-			_x_ = x - SQ_LEFTUP_X - R;
-			_y_ = y - SQ_LEFTUP_Y - R;
-
-			for (uint8_t row = 0; row < (2 * R + 1); row++) {
-				memset(&frameBuffer[SQ_SIDE * (_y_ + row) + _x_], 127, (2 * R + 1));
-			}
-
-			ili9341_fillCircle(x, y, R, BLACK);
+			// joined to the previous sample of the stroke, in frameBuffer and on screen
+			stroke_add_point(x - SQ_LEFTUP_X, y - SQ_LEFTUP_Y);
 
 			return VALID_TOUCH;
 		} else {
+			stroke_pen_up();
 			return INVALID_TOUCH;
 		}
 	} else {
+		stroke_pen_up();
 		return NO_TOUCH;
 	}
 }
 
-static void resize(uint8_t* p_frame_buffer, uint8_t* p_mnist_buffer)
+static uint32_t GetUs(void)
 {
-	int resize_ratio = SQ_SIDE / 28;
+	struct timespec now;
 
-	for (int y = 0; y < 28; y++) {
-		for (int x = 0; x < 28; x++) {
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint32_t)((uint64_t)now.tv_sec * 1000000u + now.tv_nsec / 1000);
+}
 
-			int in = (y * SQ_SIDE + x) * resize_ratio;
-			int out = (y * 28 + x);
+static bool RouteLocal(void)
+{
+	if (!local_nn_idle()) {
+		return false;
+	}
 
-			p_mnist_buffer[out] = p_frame_buffer[in];
-		}
+	if (rtStalled || (outstanding >= rtCredits)) {
+		return true;
 	}
+
+	// every request the RT core holds is answered before this one
+	return (rtLatencyUs != 0) && ((outstanding + 1) * rtLatencyUs > local_nn_latency_us());
 }
 
-static void TimerEventHandler(EventData* eventData)
+static void SubmitLocal(void)
 {
-	uint16_t x, y, _x_, _y_;
+	if (local_nn_submit(&request) != 0) {
+		sendDropped++;
+		return;
+	}
+	localCount++;
+}
+
+static void SendRequest(void)
+{
+	ssize_t bytesSent = send(rtSocketFd, &request, sizeof(request), 0);
+	if (bytesSent < 0) {
+		Log_Debug("ERROR: Unable to send message: %d (%s)\r\n", errno, strerror(errno));
+		sendDropped++;
+	} else if (bytesSent != sizeof(request)) {
+		Log_Debug("ERROR: Write %d bytes, expect %d bytes\r\n", bytesSent, sizeof(request));
+		sendDropped++;
+	} else {
+		outstanding++;
+		response_count = RESPONSE_TO;
+		sentUs[request.seq] = GetUs();
+	}
+}
 
-	static WorkStateMachine_t workState = SM_IDLE;
+static void SubmitRequest(void)
+{
+	request.seq++;
+	request.flags = 0;
 
-#define DONE_TO		20 // 20 x 20 = 400ms
+	if (RouteLocal()) {
+		SubmitLocal();
+		return;
+	}
+
+	if (outstanding < rtCredits) {
+		SendRequest();
+		return;
+	}
+
+	// RT core is busy, only the latest drawing is worth sending
+	if (requestPending) {
+		sendDropped++;
+	}
+	requestPending = true;
+	sendDeferred++;
+}
+
+static void SubmitSnapshot(void)
+{
+	// a deferred final request lives in the same buffer, leave it alone.
+	// snapshots stay on the RT core while it has a credit, they also tell when it is back
+	bool local = (outstanding >= rtCredits);
+	if (requestPending || (local && !local_nn_idle())) {
+		return;
+	}
+
+	if (preprocess_cells(&cellBuffer[0], SQ_SIDE / STROKE_CELL, SQ_SIDE / STROKE_CELL,
+		STROKE_CELL * STROKE_CELL, (int8_t*)&request.image[0]) < 0) {
+		return;
+	}
+
+	request.seq++;
+	request.flags = REQ_FLAG_SPECULATIVE;
+	if (local) {
+		SubmitLocal();
+	} else {
+		SendRequest();
+	}
+
+	snapshot_count = 0;
+	snapshotInk = false;
+}
+
+static void TouchEventHandler(EventData* eventData)
+{
+	if (ConsumeTimerFdEvent(touchTimerFd) != 0) {
+		terminationRequired = true;
+		return;
+	}
+
+	// input is ignored while the result is on screen
+	if (workState == SM_DONE) {
+		return;
+	}
+
+	// no I2C traffic unless the controller asserts INT
+	uint8_t ret = checkTouchAndDrawPoint();
+	if (ret > touchSeen) {
+		touchSeen = ret;
+	}
+
+	// show the ink now rather than at the next state machine tick
+	if (ret == VALID_TOUCH) {
+		if (canvas_flush() < 0) {
+			Log_Debug("ERROR: canvas_flush failed\r\n");
+		}
+	}
+}
+
+static void TimerEventHandler(EventData* eventData)
+{
+#define DONE_TO_MIN	8  // 8 x 20 = 160ms
+#define DONE_TO_MAX	20 // 20 x 20 = 400ms
+#define GAP_MIN		2  // shorter breaks are touch jitter, not a pause between strokes
 #define CLEAN_TO	50 // 50 x 20 = 1s
 
-	static uint32_t done_count = DONE_TO;
+	// end of input is declared after twice the usual pause between strokes of a digit
+	static uint32_t gap_avg = DONE_TO_MAX / 2;
+	static uint32_t gap_count = 0;
 	static uint32_t clean_count = CLEAN_TO;
 
 	if (ConsumeTimerFdEvent(timerFd) != 0) {
@@ -122,54 +281,278 @@ static void TimerEventHandler(EventData* eventData)
 		return;
 	}
 
+	// RT core stopped answering (e.g. restarted), start over with the initial credits
+	if ((outstanding > 0) && (--response_count == 0)) {
+		Log_Debug("WARNING: no response from RT core for %d request(s)\r\n", outstanding);
+		outstanding = 0;
+		rtCredits = INTERCORE_INITIAL_CREDITS;
+		rtStalled = true;
+		if (requestPending) {
+			requestPending = false;
+			if (RouteLocal()) {
+				SubmitLocal();
+			} else {
+				SendRequest();
+			}
+		}
+	}
+
+	uint8_t ret = touchSeen;
+	touchSeen = NO_TOUCH;
+
 	if (workState == SM_IDLE) {
-		if (checkTouchAndDrawPoint() == VALID_TOUCH) {
+		if (ret == VALID_TOUCH) {
 			workState = SM_DRAWING;
-			done_count = DONE_TO;
+			gap_count = 0;
+			snapshot_count = 0;
+			snapshotInk = true;
 		}
 	} else if (workState == SM_DRAWING) {
-		uint8_t ret = checkTouchAndDrawPoint();
 		if ((ret == NO_TOUCH) || (ret == INVALID_TOUCH)) {
-			done_count--;
-			if (done_count == 0) {
-				workState = SM_DONE;
+			uint32_t done_to = 2 * gap_avg;
+			if (done_to < DONE_TO_MIN) done_to = DONE_TO_MIN;
+			if (done_to > DONE_TO_MAX) done_to = DONE_TO_MAX;
 
-				resize(&frameBuffer[0], &mnistBuffer[0]);
+			gap_count++;
+			if (gap_count >= done_to) {
+				workState = SM_DONE;
 
-				ssize_t bytesSent = send(rtSocketFd, &mnistBuffer[0], MINST_BUF_SIZE, 0);
-				if (bytesSent < 0) {
-					Log_Debug("ERROR: Unable to send message: %d (%s)\r\n", errno, strerror(errno));
-				} else if (bytesSent != MINST_BUF_SIZE) {
-					Log_Debug("ERROR: Write %d bytes, expect %d bytes\r\n", bytesSent, MINST_BUF_SIZE);
+				// cells were summed while drawing, only the normalisation is left
+				if (preprocess_cells(&cellBuffer[0], SQ_SIDE / STROKE_CELL, SQ_SIDE / STROKE_CELL,
+					STROKE_CELL * STROKE_CELL, (int8_t*)&request.image[0]) == 0) {
+					SubmitRequest();
 				}
 			}
 		} else {
-			done_count = DONE_TO;
+			if (gap_count >= GAP_MIN) {
+				gap_avg = (3 * gap_avg + gap_count + 2) / 4;
+			}
+			gap_count = 0;
+			snapshotInk = true;
+		}
+
+		// the digit is still growing, classify what is there so far
+		if (workState == SM_DRAWING) {
+			snapshot_count++;
+			if (snapshotInk && (snapshot_count >= SNAPSHOT_TO)) {
+				SubmitSnapshot();
+			}
 		}
 	} else if (workState == SM_DONE) {
 		clean_count--;
 		if (clean_count == 0) {
-			ili9341_draw_bitmap(SQ_LEFTUP_X, SQ_LEFTUP_Y, SQ_SIDE, SQ_SIDE, &cleanBitmap[0]);
-			memset(&frameBuffer[0], 0, SQ_SIDE * SQ_SIDE);
+			canvas_clear(WHITE);
+			memset(&frameBuffer[0], 0, sizeof(frameBuffer));
+			memset(&cellBuffer[0], 0, sizeof(cellBuffer));
 
 			workState = SM_IDLE;
 			clean_count = CLEAN_TO;
 		}
 	}
+
+	// everything drawn in this tick goes to the LCD in one window
+	if (canvas_flush() < 0) {
+		Log_Debug("ERROR: canvas_flush failed\r\n");
+	}
+}
+
+static void HandleTelemetry(const IntercoreTelemetry_t* t)
+{
+	Log_Debug("RT telemetry: %d inferences in %d ms, result cache %d hits / %d misses\r\n",
+		t->inferences, t->periodMs, t->cacheHits, t->cacheMisses);
+
+	Log_Debug("  round trip avg %d us, local %d us, %d requests ran locally\r\n",
+		rtLatencyUs, local_nn_latency_us(), localCount);
+
+	Log_Debug("  queue %d (peak %d), heap high-water %d / %d bytes\r\n",
+		t->queueDepth, t->queuePeak, t->heapHighWater, t->heapTotal);
+
+	Log_Debug("  %d snapshots preempted by final requests, %d missed their deadline\r\n",
+		t->preemptions, t->deadlineMisses);
+
+	// every request of the period may have been a cache hit
+	if (t->inferences == 0) {
+		return;
+	}
+
+	Log_Debug("  latency min %d avg %d max %d us\r\n",
+		t->latencyMinUs, t->latencySumUs / t->inferences, t->latencyMaxUs);
+
+	Log_Debug("  histogram(ms):");
+	for (int i = 0; i < TELEMETRY_HIST_BINS; i++) {
+		Log_Debug(" %s%d:%d", (i == TELEMETRY_HIST_BINS - 1) ? ">=" : "<",
+			(i == TELEMETRY_HIST_BINS - 1) ? (1 << (i - 1)) : (1 << i), t->histogram[i]);
+	}
+	Log_Debug("\r\n");
+
+	Log_Debug("  layer avg(us):");
+	for (int i = 0; (i < t->layerCount) && (i < TELEMETRY_LAYER_MAX); i++) {
+		Log_Debug(" #%d:%d", i + 1, t->layerUs[i] / t->inferences);
+	}
+	Log_Debug("\r\n");
+}
+
+// The RT core which took the request is done with it
+static void ReturnCredit(uint8_t credits)
+{
+	if (outstanding > 0) {
+		outstanding--;
+	}
+	response_count = RESPONSE_TO;
+	rtCredits = credits;
+	rtStalled = false;
+
+	if (requestPending && (outstanding < rtCredits)) {
+		requestPending = false;
+		SendRequest();
+	}
+}
+
+static void ShowResult(const IntercoreClassifyResult_t* result)
+{
+	if (result->dropped || result->deferred || sendDropped || sendDeferred) {
+		Log_Debug("INFO: RT dropped %d deferred %d, HL dropped %d deferred %d\r\n",
+			result->dropped, result->deferred, sendDropped, sendDeferred);
+	}
+
+	// result of a superseded drawing is not displayed, a guess made while drawing is grey
+	if ((result->seq == request.seq) && !(result->flags & RESULT_FLAG_CANCELLED)) {
+		bool speculative = (result->flags & RESULT_FLAG_SPECULATIVE) != 0;
+		bool rejected = !speculative && (result->confidence < CONFIDENCE_MIN);
+
+		lcd_set_text_color(speculative ? DGRAY : BLACK);
+		lcd_set_text_cursor(241, 12);
+		lcd_display_char(rejected ? '?' : (0x30 + result->label));
+
+		if (!speculative) {
+			Log_Debug("Result %d (%d%%), next", result->label, result->confidence);
+			for (int i = 1; i < INTERCORE_TOPK; i++) {
+				Log_Debug(" %d (%d/127)", result->topk[i], result->probs[result->topk[i]]);
+			}
+			Log_Debug("%s\r\n", rejected ? ", rejected" : "");
+		}
+	}
 }
 
+static void RecordRoundTrip(const IntercoreClassifyResult_t* result)
+{
+	// a cancelled request never ran
+	if (result->flags & RESULT_FLAG_CANCELLED) {
+		return;
+	}
+
+	uint32_t us = GetUs() - sentUs[result->seq];
+	rtLatencyUs = (rtLatencyUs == 0) ? us : (3 * rtLatencyUs + us) / 4;
+}
+
+static void HandleResult(const IntercoreClassifyResult_t* result)
+{
+	RecordRoundTrip(result);
+	ShowResult(result);
+	ReturnCredit(result->credits);
+}
+
+static void LocalResultEventHandler(EventData* eventData)
+{
+	IntercoreClassifyResult_t result;
+
+	if (local_nn_result(&result) != 0) {
+		return;
+	}
+
+	ShowResult(&result);
+
+	// a deferred request goes to whichever side is free first
+	if (requestPending) {
+		requestPending = false;
+		SubmitLocal();
+	}
+}
+
+typedef union {
+	uint8_t type;
+	IntercoreClassifyResult_t result;
+	IntercoreTelemetry_t telemetry;
+	IntercoreActivation_t activation;
+} RtMessage_t;
+
+#if defined(RT_PIPELINE)
+static void RelayActivation(const IntercoreActivation_t* activation)
+{
+	ssize_t bytesSent = send(rtBackSocketFd, activation, sizeof(*activation), 0);
+	if (bytesSent == -1) {
+		Log_Debug("ERROR: Unable to relay activations of seq %d: %d (%s)\r\n", activation->seq, errno, strerror(errno));
+	}
+
+	// front stage is free for the next request once the last chunk is out
+	if (activation->offset + activation->length >= activation->total) {
+		ReturnCredit(activation->credits);
+	}
+}
+
+static void BackSocketEventHandler(EventData* eventData)
+{
+	RtMessage_t msg;
+
+	ssize_t bytesReceived = recv(rtBackSocketFd, &msg, sizeof(msg), 0);
+	if (bytesReceived < 0) {
+		Log_Debug("ERROR: Unable to receive message: %d (%s)\r\n", errno, strerror(errno));
+		return;
+	}
+
+	// credits are only counted against the front stage
+	if ((msg.type == MSG_CLASSIFY_RESULT) && (bytesReceived == sizeof(msg.result))) {
+		RecordRoundTrip(&msg.result);
+		ShowResult(&msg.result);
+	} else if ((msg.type == MSG_TELEMETRY) && (bytesReceived == sizeof(msg.telemetry)) && (msg.telemetry.inferences > 0)) {
+		HandleTelemetry(&msg.telemetry);
+	} else {
+		Log_Debug("ERROR: Unexpected message from back stage, %d bytes\r\n", bytesReceived);
+	}
+}
+#endif
+
 static void SocketEventHandler(EventData* eventData)
 {
-	uint8_t number;
-	ssize_t bytesReceived = recv(rtSocketFd, &number, sizeof(number), 0);
+	RtMessage_t msg;
+
+	ssize_t bytesReceived = recv(rtSocketFd, &msg, sizeof(msg), 0);
 	if (bytesReceived < 0) {
 		Log_Debug("ERROR: Unable to receive message: %d (%s)\r\n", errno, strerror(errno));
 		return;
 	}
 
-	lcd_set_text_cursor(241, 12);
-	lcd_display_char(0x30 + number);
+	if ((msg.type == MSG_CLASSIFY_RESULT) && (bytesReceived == sizeof(msg.result))) {
+		HandleResult(&msg.result);
+#if defined(RT_PIPELINE)
+	} else if ((msg.type == MSG_ACTIVATION) && (bytesReceived == sizeof(msg.activation))) {
+		RelayActivation(&msg.activation);
+#endif
+	} else if ((msg.type == MSG_TELEMETRY) && (bytesReceived == sizeof(msg.telemetry)) && (msg.telemetry.inferences > 0)) {
+		HandleTelemetry(&msg.telemetry);
+	} else {
+		Log_Debug("ERROR: Unexpected message, %d bytes\r\n", bytesReceived);
+	}
+}
+
+#if defined(LCD_BENCHMARK)
+static void BenchmarkLcdFill(uint16_t width, uint16_t height)
+{
+	struct timespec start, end;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (uint32_t i = 0; i < LCD_BENCHMARK_FILLS; i++) {
+		ili9341_fill_rect(0, 0, width, height, (i & 1) ? BLACK : WHITE);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	uint32_t us = (uint32_t)((int64_t)(end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000);
+	uint32_t fps100 = (uint32_t)((uint64_t)LCD_BENCHMARK_FILLS * 100000000 / us);
+
+	Log_Debug("LCD benchmark: %dx%d, %d fills in %d us, %d.%02d fills/s\r\n",
+		width, height, LCD_BENCHMARK_FILLS, us, fps100 / 100, fps100 % 100);
 }
+#endif
 
 static int InitPeripheralsAndHandlers(void)
 {
@@ -192,6 +575,21 @@ static int InitPeripheralsAndHandlers(void)
 		return -1;
 	}
 
+	// Touch is sampled faster than the state machine, a sample only reads the INT level until the panel is touched
+	static const struct timespec touchPeriod = { .tv_sec = 0, .tv_nsec = 5000000 };
+	touchTimerFd = CreateTimerFdAndAddToEpoll(epollFd, &touchPeriod, &touchEventData, EPOLLIN);
+	if (touchTimerFd < 0) {
+		return -1;
+	}
+
+	// Fallback when the RT core is busy or gone, the app still works without it
+	localFd = local_nn_init();
+	if (localFd < 0) {
+		Log_Debug("WARNING: local inference not available\n");
+	} else if (RegisterEventHandlerToEpoll(epollFd, localFd, &localEventData, EPOLLIN) != 0) {
+		return -1;
+	}
+
 	// Open connection to real-time capable application.
 	rtSocketFd = Application_Socket(rtAppComponentId);
 	if (rtSocketFd == -1) {
@@ -211,7 +609,32 @@ static int InitPeripheralsAndHandlers(void)
 		return -1;
 	}
 
+#if defined(RT_PIPELINE)
+	rtBackSocketFd = Application_Socket(rtBackAppComponentId);
+	if (rtBackSocketFd == -1) {
+		Log_Debug("ERROR: Unable to create back stage socket: %d (%s)\n", errno, strerror(errno));
+		return -1;
+	}
+
+	ret = setsockopt(rtBackSocketFd, SOL_SOCKET, SO_RCVTIMEO, &to, sizeof(to));
+	if (ret == -1) {
+		Log_Debug("ERROR: Unable to set socket timeout: %d (%s)\n", errno, strerror(errno));
+		return -1;
+	}
+
+	if (RegisterEventHandlerToEpoll(epollFd, rtBackSocketFd, &backSocketEventData, EPOLLIN) != 0) {
+		return -1;
+	}
+#endif
+
 	ili9341_init();
+#if defined(LCD_BENCHMARK)
+	BenchmarkLcdFill(SQ_SIDE, SQ_SIDE);
+	BenchmarkLcdFill(ILI9341_LCD_PIXEL_WIDTH, ILI9341_LCD_PIXEL_HEIGHT);
+	ili9341_clean_screen(WHITE);
+#endif
+	canvas_init(SQ_LEFTUP_X, SQ_LEFTUP_Y, WHITE);
+	stroke_init(&frameBuffer[0], &cellBuffer[0], SQ_SIDE, SQ_SIDE, R);
 	ili9341_draw_rect(SQ_LEFTUP_X - 1, SQ_LEFTUP_Y - 1, SQ_SIDE + 2, SQ_SIDE + 2, RED);
 	lcd_set_text_size(2);
 	lcd_set_text_cursor(70, 12);
@@ -226,7 +649,12 @@ static void CloseHandlers(void)
 {
 	Log_Debug("Closing file descriptors.\n");
 	CloseFdAndPrintError(rtSocketFd, "Socket");
+#if defined(RT_PIPELINE)
+	CloseFdAndPrintError(rtBackSocketFd, "BackSocket");
+#endif
+	local_nn_close();
 	CloseFdAndPrintError(timerFd, "Timer");
+	CloseFdAndPrintError(touchTimerFd, "TouchTimer");
 	CloseFdAndPrintError(epollFd, "Epoll");
 }
 
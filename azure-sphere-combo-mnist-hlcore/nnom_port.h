@@ -0,0 +1,39 @@
+#ifndef __NNOM_PORT_H__
+#define __NNOM_PORT_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <applibs/log.h>
+
+// nnom port of the HL app, used by local_nn.c. The library itself lives in the RT project.
+
+static inline uint32_t nnom_hl_us(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)((uint64_t)ts.tv_sec * 1000000u + ts.tv_nsec / 1000);
+}
+
+// memory interfaces
+#define nnom_malloc(n)      malloc(n) 
+#define nnom_free(p)        free(p)
+#define nnom_memset(p,v,s)  memset(p,v,s)
+
+// runtime & debuges
+#define nnom_us_get()       nnom_hl_us()
+#define nnom_ms_get()       (nnom_hl_us() / 1000)
+#define NNOM_LOG(...)       Log_Debug(__VA_ARGS__)
+
+// NNoM configuration
+#define NNOM_BLOCK_NUM  	(8)		// maximum number of memory block  
+#define DENSE_WEIGHT_OPT 	(1)		// if used fully connected layer optimized weights. 
+
+// Backend selection
+// CMSIS-NN is for the Cortex-M only, the local backend gives the same results as the RT app
+
+#endif
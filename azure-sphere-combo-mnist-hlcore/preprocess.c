@@ -0,0 +1,178 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "preprocess.h"
+
+#define MAX_SRC_SIDE	256
+
+// Vertical pass result, PREPROCESS_FIT_SIDE rows of up to MAX_SRC_SIDE columns
+static uint32_t s_vert[PREPROCESS_FIT_SIDE * MAX_SRC_SIDE];
+static uint8_t s_fit[PREPROCESS_FIT_SIDE * PREPROCESS_FIT_SIDE];
+static uint8_t s_cellImage[MAX_SRC_SIDE * MAX_SRC_SIDE / 4];
+
+// Area resampling in integer units: a source pixel is out_len units long and an output
+// pixel is src_len units long, so both axes span src_len * out_len units.
+static uint32_t _overlap(uint32_t o, uint32_t i, uint32_t src_len, uint32_t out_len)
+{
+	uint32_t start = (o * src_len > i * out_len) ? o * src_len : i * out_len;
+	uint32_t end = ((o + 1) * src_len < (i + 1) * out_len) ? (o + 1) * src_len : (i + 1) * out_len;
+
+	return (end > start) ? (end - start) : 0;
+}
+
+static int _bounding_box(const uint8_t* p_src, uint16_t width, uint16_t height,
+	uint16_t* p_x0, uint16_t* p_y0, uint16_t* p_x1, uint16_t* p_y1)
+{
+	int found = 0;
+
+	*p_x0 = width;
+	*p_y0 = height;
+	*p_x1 = 0;
+	*p_y1 = 0;
+
+	for (uint16_t y = 0; y < height; y++) {
+		const uint8_t* p_row = &p_src[y * width];
+
+		for (uint16_t x = 0; x < width; x++) {
+			if (p_row[x]) {
+				if (x < *p_x0) *p_x0 = x;
+				if (x > *p_x1) *p_x1 = x;
+				if (y < *p_y0) *p_y0 = y;
+				*p_y1 = y;
+				found = 1;
+			}
+		}
+	}
+
+	return found ? 0 : -1;
+}
+
+// Box filter of the w x h crop at p_src (row pitch = pitch) into s_fit[fit_h][fit_w]
+static void _area_scale(const uint8_t* p_src, uint16_t pitch, uint16_t w, uint16_t h,
+	uint16_t fit_w, uint16_t fit_h)
+{
+	uint32_t norm = (uint32_t)w * h;
+
+	// vertical first: each output row is a weighted sum of whole source rows, the inner
+	// loop is a plain multiply-accumulate over contiguous pixels which the compiler vectorises
+	for (uint16_t oy = 0; oy < fit_h; oy++) {
+		uint32_t* p_acc = &s_vert[oy * MAX_SRC_SIDE];
+		uint32_t first = (oy * (uint32_t)h) / fit_h;
+		uint32_t last = ((oy + 1) * (uint32_t)h - 1) / fit_h;
+
+		memset(p_acc, 0, w * sizeof(uint32_t));
+
+		for (uint32_t i = first; i <= last; i++) {
+			const uint8_t* p_row = &p_src[i * pitch];
+			uint32_t weight = _overlap(oy, i, h, fit_h);
+
+			for (uint16_t x = 0; x < w; x++) {
+				p_acc[x] += weight * p_row[x];
+			}
+		}
+	}
+
+	// horizontal pass on the already reduced rows
+	for (uint16_t ox = 0; ox < fit_w; ox++) {
+		uint32_t first = (ox * (uint32_t)w) / fit_w;
+		uint32_t last = ((ox + 1) * (uint32_t)w - 1) / fit_w;
+
+		for (uint16_t oy = 0; oy < fit_h; oy++) {
+			const uint32_t* p_acc = &s_vert[oy * MAX_SRC_SIDE];
+			uint32_t sum = 0;
+
+			for (uint32_t i = first; i <= last; i++) {
+				sum += _overlap(ox, i, w, fit_w) * p_acc[i];
+			}
+
+			s_fit[oy * fit_w + ox] = (uint8_t)((sum + norm / 2) / norm);
+		}
+	}
+}
+
+static int _com_offset(uint32_t moment, uint32_t mass, uint16_t fit_len)
+{
+	// pixel x has its centre at x + 0.5, shift the centre of mass onto PREPROCESS_OUT_SIDE / 2
+	int offset = (int)((float)PREPROCESS_OUT_SIDE / 2 - ((float)moment / mass + 0.5f) + 0.5f);
+
+	if (offset < 0) {
+		offset = 0;
+	} else if (offset > PREPROCESS_OUT_SIDE - fit_len) {
+		offset = PREPROCESS_OUT_SIDE - fit_len;
+	}
+
+	return offset;
+}
+
+int preprocess_mnist(const uint8_t* p_src, uint16_t width, uint16_t height, int8_t* p_out)
+{
+	uint16_t x0, y0, x1, y1;
+
+	if ((width > MAX_SRC_SIDE) || (height > MAX_SRC_SIDE)) {
+		return -1;
+	}
+
+	if (_bounding_box(p_src, width, height, &x0, &y0, &x1, &y1) < 0) {
+		return -1;
+	}
+
+	uint16_t w = x1 - x0 + 1;
+	uint16_t h = y1 - y0 + 1;
+	uint16_t fit_w, fit_h;
+
+	// keep the aspect ratio, the longer side becomes PREPROCESS_FIT_SIDE
+	if (w >= h) {
+		fit_w = PREPROCESS_FIT_SIDE;
+		fit_h = (uint16_t)((h * PREPROCESS_FIT_SIDE + w / 2) / w);
+	} else {
+		fit_h = PREPROCESS_FIT_SIDE;
+		fit_w = (uint16_t)((w * PREPROCESS_FIT_SIDE + h / 2) / h);
+	}
+	if (fit_w == 0) fit_w = 1;
+	if (fit_h == 0) fit_h = 1;
+
+	_area_scale(&p_src[y0 * width + x0], width, w, h, fit_w, fit_h);
+
+	uint32_t mass = 0, mx = 0, my = 0;
+	for (uint16_t y = 0; y < fit_h; y++) {
+		for (uint16_t x = 0; x < fit_w; x++) {
+			uint8_t v = s_fit[y * fit_w + x];
+			mass += v;
+			mx += x * v;
+			my += y * v;
+		}
+	}
+
+	if (mass == 0) {
+		return -1;
+	}
+
+	int ox = _com_offset(mx, mass, fit_w);
+	int oy = _com_offset(my, mass, fit_h);
+
+	memset(p_out, 0, PREPROCESS_OUT_SIDE * PREPROCESS_OUT_SIDE);
+	for (uint16_t y = 0; y < fit_h; y++) {
+		for (uint16_t x = 0; x < fit_w; x++) {
+			uint8_t v = s_fit[y * fit_w + x];
+			p_out[(oy + y) * PREPROCESS_OUT_SIDE + (ox + x)] = (int8_t)((v > 127) ? 127 : v);
+		}
+	}
+
+	return 0;
+}
+
+int preprocess_cells(const uint16_t* p_cells, uint16_t cells_w, uint16_t cells_h, uint16_t cell_area, int8_t* p_out)
+{
+	uint32_t n = (uint32_t)cells_w * cells_h;
+
+	if ((n > sizeof(s_cellImage)) || (cell_area == 0)) {
+		return -1;
+	}
+
+	// average intensity of each cell, the rest is the full resolution pipeline on a small image
+	for (uint32_t i = 0; i < n; i++) {
+		s_cellImage[i] = (uint8_t)((p_cells[i] + cell_area / 2) / cell_area);
+	}
+
+	return preprocess_mnist(&s_cellImage[0], cells_w, cells_h, p_out);
+}
@@ -0,0 +1,18 @@
+#ifndef __PREPROCESS_H
+#define __PREPROCESS_H
+
+#include <stdint.h>
+
+// Turns the drawing into a 28x28 model input the way MNIST digits were prepared:
+// crop to the ink, area-scale the longer side to 20 pixels, then move the centre of
+// mass to the middle of the 28x28 image. Output is q7 with 1.0 = 127 (input shift 7).
+#define PREPROCESS_OUT_SIDE		28
+#define PREPROCESS_FIT_SIDE		20
+
+// p_src holds width x height pixels in 0..127, returns -1 if there is no ink
+int preprocess_mnist(const uint8_t* p_src, uint16_t width, uint16_t height, int8_t* p_out);
+
+// Same, starting from per-cell ink sums (cell_area pixels per cell) kept while drawing
+int preprocess_cells(const uint16_t* p_cells, uint16_t cells_w, uint16_t cells_h, uint16_t cell_area, int8_t* p_out);
+
+#endif
@@ -0,0 +1,121 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ili9341.h"
+#include "canvas.h"
+#include "stroke.h"
+
+// Stamps along a segment are at most r / 2 apart, and never more than this many per
+// segment so a long jump can not stall the event loop
+#define STROKE_MAX_STAMPS	32
+
+#define INK_LEVEL			127
+
+static uint8_t* s_capture;
+static uint16_t* s_cells;
+static uint16_t s_width, s_height;
+static uint16_t s_cellsPerRow;
+static uint16_t s_r;
+
+// Disc with a 1 pixel soft edge, max-blended into the capture buffer
+static uint8_t s_stamp[(2 * STROKE_MAX_R + 1) * (2 * STROKE_MAX_R + 1)];
+
+static bool s_penDown;
+static int16_t s_lastX, s_lastY;
+
+static void _stamp(int16_t x0, int16_t y0)
+{
+	uint16_t side = 2 * s_r + 1;
+
+	for (int16_t dy = -(int16_t)s_r; dy <= (int16_t)s_r; dy++) {
+		int16_t y = y0 + dy;
+		if ((y < 0) || (y >= (int16_t)s_height)) {
+			continue;
+		}
+
+		const uint8_t* p_mask = &s_stamp[(dy + s_r) * side];
+		uint8_t* p_row = &s_capture[y * s_width];
+		uint16_t* p_cellRow = &s_cells[(y / STROKE_CELL) * s_cellsPerRow];
+
+		for (int16_t dx = -(int16_t)s_r; dx <= (int16_t)s_r; dx++) {
+			int16_t x = x0 + dx;
+			if ((x < 0) || (x >= (int16_t)s_width)) {
+				continue;
+			}
+
+			uint8_t v = p_mask[dx + s_r];
+			if (v > p_row[x]) {
+				p_cellRow[x / STROKE_CELL] += v - p_row[x];
+				p_row[x] = v;
+			}
+		}
+	}
+
+	canvas_fill_circle(x0, y0, s_r, BLACK);
+}
+
+void stroke_init(uint8_t* p_capture, uint16_t* p_cells, uint16_t width, uint16_t height, uint16_t r)
+{
+	s_capture = p_capture;
+	s_cells = p_cells;
+	s_cellsPerRow = width / STROKE_CELL;
+	s_width = width;
+	s_height = height;
+	s_r = (r > STROKE_MAX_R) ? STROKE_MAX_R : r;
+	s_penDown = false;
+
+	uint16_t side = 2 * s_r + 1;
+	int32_t inner = (int32_t)(s_r - 1) * (s_r - 1);
+	int32_t outer = (int32_t)(s_r + 1) * (s_r + 1);
+
+	// full ink inside r - 1, linear ramp on d^2 out to r + 1
+	for (int16_t dy = -(int16_t)s_r; dy <= (int16_t)s_r; dy++) {
+		for (int16_t dx = -(int16_t)s_r; dx <= (int16_t)s_r; dx++) {
+			int32_t d2 = dx * dx + dy * dy;
+			uint8_t v;
+
+			if (d2 <= inner) {
+				v = INK_LEVEL;
+			} else if (d2 >= outer) {
+				v = 0;
+			} else {
+				v = (uint8_t)(INK_LEVEL * (outer - d2) / (outer - inner));
+			}
+
+			s_stamp[(dy + s_r) * side + (dx + s_r)] = v;
+		}
+	}
+}
+
+void stroke_add_point(int16_t x, int16_t y)
+{
+	if (!s_penDown) {
+		_stamp(x, y);
+	} else {
+		int16_t dx = x - s_lastX;
+		int16_t dy = y - s_lastY;
+		int16_t adx = (dx < 0) ? -dx : dx;
+		int16_t ady = (dy < 0) ? -dy : dy;
+		int16_t len = (adx > ady) ? adx : ady;
+		int16_t step = (s_r / 2 > 0) ? s_r / 2 : 1;
+		int16_t n = (len + step - 1) / step;
+
+		if (n > STROKE_MAX_STAMPS) {
+			n = STROKE_MAX_STAMPS;
+		}
+
+		// last stamp of the previous segment is already there, start from i = 1
+		for (int16_t i = 1; i <= n; i++) {
+			_stamp(s_lastX + (dx * i) / n, s_lastY + (dy * i) / n);
+		}
+	}
+
+	s_lastX = x;
+	s_lastY = y;
+	s_penDown = true;
+}
+
+void stroke_pen_up(void)
+{
+	s_penDown = false;
+}
@@ -0,0 +1,18 @@
+#ifndef __STROKE_H
+#define __STROKE_H
+
+#include <stdint.h>
+
+// Joins consecutive touch samples of a stroke with a thick segment, drawn into
+// the 8bit capture buffer (anti-aliased) and the LCD canvas
+#define STROKE_MAX_R		16
+
+// Ink added to the capture buffer is also summed per STROKE_CELL x STROKE_CELL block,
+// so a downsampled image is ready as soon as the stroke ends
+#define STROKE_CELL			6
+
+void stroke_init(uint8_t* p_capture, uint16_t* p_cells, uint16_t width, uint16_t height, uint16_t r);
+void stroke_add_point(int16_t x, int16_t y);
+void stroke_pen_up(void);
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef __INTERCORE_MSG_H
+#define __INTERCORE_MSG_H
+
+#include <stdint.h>
+
+// Messages exchanged between the HL app and the RT app over the intercore socket.
+// Both projects carry a copy of this file, keep them identical.
+
+#define INTERCORE_IMAGE_SIZE		784	// 28 * 28
+#define INTERCORE_CLASSES			10
+#define INTERCORE_TOPK				3
+
+#define MSG_CLASSIFY_REQ			0x01
+#define MSG_ACTIVATION				0x02	// front stage -> HL app -> back stage, relayed unchanged
+#define MSG_CLASSIFY_RESULT			0x81
+#define MSG_TELEMETRY				0x82
+
+// Credits the HL app assumes before the first result tells it the real number
+#define INTERCORE_INITIAL_CREDITS	1
+
+// Request flags
+#define REQ_FLAG_SPECULATIVE		0x01	// snapshot of a drawing in progress, may be superseded
+
+// Result flags
+#define RESULT_FLAG_SPECULATIVE		0x01	// answers a speculative request
+#define RESULT_FLAG_CANCELLED		0x02	// request was superseded before it ran, label is not valid
+
+typedef struct __attribute__((packed)) {
+	uint8_t type;		// MSG_CLASSIFY_REQ
+	uint8_t seq;
+	uint8_t flags;		// REQ_FLAG_xxx
+	uint8_t reserved;
+	uint8_t image[INTERCORE_IMAGE_SIZE];
+} IntercoreClassifyReq_t;
+
+typedef struct __attribute__((packed)) {
+	uint8_t type;		// MSG_CLASSIFY_RESULT
+	uint8_t seq;		// seq of the request this result answers
+	uint8_t credits;	// number of requests the HL app may have in flight
+	uint8_t label;		// same as topk[0]
+	uint8_t flags;		// RESULT_FLAG_xxx
+	uint8_t confidence;	// probability of label in percent
+	uint16_t dropped;	// results the RT app had to throw away since start
+	uint16_t deferred;	// results which waited in the RT app for space in the shared buffer
+	int8_t probs[INTERCORE_CLASSES];	// softmax output per class, q7 (127 = 1.0)
+	uint8_t topk[INTERCORE_TOPK];		// best classes first
+} IntercoreClassifyResult_t;
+
+// Activations handed from the front to the back stage when the model is split across both
+// RT cores. RT apps can only talk to the HL app, which forwards every chunk as it is.
+// A tensor larger than one chunk is sent in order as several messages.
+#define INTERCORE_ACT_CHUNK			768
+
+typedef struct __attribute__((packed)) {
+	uint8_t type;		// MSG_ACTIVATION
+	uint8_t seq;		// seq of the request the activations belong to
+	uint8_t flags;		// REQ_FLAG_xxx of that request
+	uint8_t credits;	// same as in a result, sent by the front stage
+	uint16_t offset;	// position of data in the tensor
+	uint16_t total;		// size of the whole tensor
+	uint16_t length;	// valid bytes in data
+	uint8_t data[INTERCORE_ACT_CHUNK];
+} IntercoreActivation_t;
+
+// Latency histogram bin i counts inferences below (1 << i) ms, the last bin takes the rest
+#define TELEMETRY_HIST_BINS			8
+#define TELEMETRY_LAYER_MAX			16
+
+// Sent by the RT app every few seconds while it is classifying, all figures cover that period
+typedef struct __attribute__((packed)) {
+	uint8_t type;		// MSG_TELEMETRY
+	uint8_t layerCount;	// valid entries in layerUs
+	uint8_t queueDepth;	// pending results when the record was sent
+	uint8_t queuePeak;	// most pending results seen in the period
+	uint16_t inferences;
+	uint16_t histogram[TELEMETRY_HIST_BINS];
+	uint32_t periodMs;
+	uint32_t latencyMinUs;
+	uint32_t latencyMaxUs;
+	uint32_t latencySumUs;
+	uint32_t heapHighWater;	// most FreeRTOS heap bytes ever in use
+	uint32_t heapTotal;
+	uint32_t layerUs[TELEMETRY_LAYER_MAX];	// per layer time summed over the period
+	uint16_t cacheHits;	// requests answered from the RT result cache, not counted in inferences
+	uint16_t cacheMisses;
+	uint16_t preemptions;	// snapshots interrupted by a final request and restarted
+	uint16_t deadlineMisses;	// snapshots dropped because they could not run in time
+} IntercoreTelemetry_t;
+
+#endif
@@ -19,6 +19,8 @@
 #include "weights.h"
 
 #include "mt3620-intercore.h"
+#include "intercore_msg.h"
+#include "result_cache.h"
 #include "Log_Debug.h"
 
 #define APP_STACK_SIZE_BYTES		(8192 / 4)
@@ -28,9 +30,85 @@ static const uintptr_t IO_CM4_RGU = 0x2101000C;
 static const uintptr_t IO_CM4_GPT_BASE = 0x21030000;
 static TaskHandle_t NNTaskHandle;
 
+// Part of the model this app runs, set by the PIPELINE_STAGE cache variable in CMakeLists.txt.
+// With one app built as the front and another as the back stage, each M4 core runs part of the
+// model and the two work on successive requests at the same time.
+#define PIPELINE_FULL		0
+#define PIPELINE_FRONT		1	// runs up to PIPELINE_SPLIT, sends the activations
+#define PIPELINE_BACK		2	// runs the rest on the activations, sends the result
+#ifndef PIPELINE_STAGE
+#define PIPELINE_STAGE		PIPELINE_FULL
+#endif
+// Last layer of the front stage in the shortcut list. The three Conv2D take nearly all the time,
+// so any split is about 2:1. 4 = max_pooling2d_2 has the smallest output, 7x7x24 in two chunks
+#define PIPELINE_SPLIT		4
+
 #define INTERBUFOVERHEAD	20
-#define MINST_DATA_SIZE		784	// 28 * 28
-static uint8_t recvBuffer[MINST_DATA_SIZE + INTERBUFOVERHEAD];
+#define MINST_DATA_SIZE		INTERCORE_IMAGE_SIZE
+#if PIPELINE_STAGE == PIPELINE_BACK
+#define REQUEST_TYPE		MSG_ACTIVATION
+#define REQUEST_SIZE		sizeof(IntercoreActivation_t)
+#else
+#define REQUEST_TYPE		MSG_CLASSIFY_REQ
+#define REQUEST_SIZE		sizeof(IntercoreClassifyReq_t)
+#endif
+static uint8_t recvBuffer[REQUEST_SIZE + INTERBUFOVERHEAD];
+#if PIPELINE_STAGE == PIPELINE_FRONT
+static uint8_t nextBuffer[REQUEST_SIZE + INTERBUFOVERHEAD];
+#endif
+static uint8_t sendBuffer[sizeof(IntercoreClassifyResult_t) + INTERBUFOVERHEAD];
+static uint8_t telemetryBuffer[sizeof(IntercoreTelemetry_t) + INTERBUFOVERHEAD];
+#if PIPELINE_STAGE == PIPELINE_FRONT
+static uint8_t activationBuffer[sizeof(IntercoreActivation_t) + INTERBUFOVERHEAD];
+// Longest wait for HL core to make room for one chunk, the HL app is gone or restarting after that
+#define ACTIVATION_TIMEOUT_MS	1000
+#endif
+
+// Results which could not be put into the shared buffer yet
+#define RESULT_QUEUE_LEN	4
+static QueueHandle_t resultQueue;
+static uint16_t droppedResults;
+static uint16_t deferredResults;
+static uint32_t cancelledRequests;
+
+static BufferHeader *outbound, *inbound;
+static uint32_t sharedBufSize;
+
+// Statistics sent to HL core, a record is only sent for periods with inferences
+#define TELEMETRY_PERIOD_MS	5000
+
+// Comment out to run every request through the model, even exact repeats.
+// A pipeline stage never sees both the image and the output, it always runs
+#if PIPELINE_STAGE == PIPELINE_FULL
+#define USE_RESULT_CACHE
+#endif
+
+#if PIPELINE_STAGE == PIPELINE_FULL
+// Requests are jobs of the nnom scheduler. A final request runs before snapshots and takes
+// the core from a running snapshot between layers. A snapshot which could not start within
+// SNAPSHOT_DEADLINE_MS is answered as cancelled, the drawing has moved on by then.
+// Another model (e.g. keyword spotting) would be added to sched_create() and share the arena.
+#define PRIO_SNAPSHOT			0
+#define PRIO_FINAL				1
+#define SNAPSHOT_DEADLINE_MS	400
+#define JOB_NUM					(RESULT_QUEUE_LEN + 1)	// HL core never has more requests in flight
+
+typedef struct {
+	nnom_sched_job_t job;
+	IntercoreClassifyReq_t request;
+	uint32_t key;
+	uint32_t startUs;
+	bool used;
+	bool superseded;	// a newer request arrived while the snapshot was running
+} ClassifyJob_t;
+
+static ClassifyJob_t jobs[JOB_NUM];
+static nnom_model_t *model;
+static nnom_delta_t *delta;
+static nnom_sched_t *sched;
+#endif
+static IntercoreTelemetry_t telemetry;
+static TickType_t telemetryStart;
 
 static _Noreturn void DefaultExceptionHandler(void);
 static _Noreturn void RTCoreMain(void);
@@ -107,48 +185,554 @@ void print_img(uint8_t* buf)
 	}
 }
 
+static int SendResult(IntercoreClassifyResult_t *result)
+{
+	if (GetEnqueueCapacity(inbound, outbound, sharedBufSize) < sizeof(sendBuffer)) {
+		return -1;
+	}
+
+	// credits and counters are filled at send time so HL core always gets the latest view
+	result->credits = (uint8_t)uxQueueSpacesAvailable(resultQueue);
+	result->dropped = droppedResults;
+	result->deferred = deferredResults;
+
+	memcpy(&sendBuffer[INTERBUFOVERHEAD], result, sizeof(IntercoreClassifyResult_t));
+
+	return EnqueueData(inbound, outbound, sharedBufSize, &sendBuffer[0], sizeof(sendBuffer));
+}
+
+static void FlushPendingResults(void)
+{
+	IntercoreClassifyResult_t result;
+
+	while (xQueuePeek(resultQueue, &result, 0) == pdTRUE) {
+		if (SendResult(&result) == -1) {
+			break;
+		}
+		(void)xQueueReceive(resultQueue, &result, 0);
+	}
+}
+
+static void PostResult(IntercoreClassifyResult_t *result)
+{
+	IntercoreClassifyResult_t oldest;
+
+	FlushPendingResults();
+
+	// keep ordering, nothing can overtake a pending result
+	if ((uxQueueMessagesWaiting(resultQueue) == 0) && (SendResult(result) == 0)) {
+		return;
+	}
+
+	if (uxQueueSpacesAvailable(resultQueue) == 0) {
+		(void)xQueueReceive(resultQueue, &oldest, 0);
+		droppedResults++;
+		Log_Debug("WARNING: result queue full, seq %d dropped\r\n", oldest.seq);
+	}
+
+	(void)xQueueSend(resultQueue, result, 0);
+	deferredResults++;
+
+	if (uxQueueMessagesWaiting(resultQueue) > telemetry.queuePeak) {
+		telemetry.queuePeak = (uint8_t)uxQueueMessagesWaiting(resultQueue);
+	}
+}
+
+static int IsValidRequest(const uint8_t *buf, uint32_t size)
+{
+	uint8_t type = buf[INTERBUFOVERHEAD];
+
+	if ((size != sizeof(recvBuffer)) || (type != REQUEST_TYPE)) {
+		Log_Debug("WARNING: unexpected message, size %d\r\n", size);
+		return 0;
+	}
+
+	return 1;
+}
+
+#if PIPELINE_STAGE != PIPELINE_BACK
+static void CancelRequest(const IntercoreClassifyReq_t *req)
+{
+	IntercoreClassifyResult_t result;
+
+	// HL core still gets an answer, it holds a credit for every request
+	memset(&result, 0, sizeof(result));
+	result.type = MSG_CLASSIFY_RESULT;
+	result.seq = req->seq;
+	result.label = 0xFF;
+	result.flags = RESULT_FLAG_CANCELLED | RESULT_FLAG_SPECULATIVE;
+	memset(result.topk, 0xFF, sizeof(result.topk));
+	PostResult(&result);
+
+	cancelledRequests++;
+}
+#endif
+
+#if PIPELINE_STAGE == PIPELINE_FRONT
+// Replace a speculative request with anything newer which is already in the shared buffer,
+// so the NN task never works on a stale snapshot. A final request is never superseded.
+// Returns true when the request was replaced.
+static bool CoalesceRequests(void)
+{
+	IntercoreClassifyReq_t *request = (IntercoreClassifyReq_t *)&recvBuffer[INTERBUFOVERHEAD];
+	uint32_t nextSize;
+	bool replaced = false;
+
+	while (request->flags & REQ_FLAG_SPECULATIVE) {
+		nextSize = sizeof(nextBuffer);
+		if (DequeueData(outbound, inbound, sharedBufSize, &nextBuffer[0], &nextSize) == -1) {
+			break;
+		}
+
+		if (!IsValidRequest(nextBuffer, nextSize)) {
+			continue;
+		}
+
+		CancelRequest(request);
+		memcpy(&recvBuffer[0], &nextBuffer[0], sizeof(recvBuffer));
+		replaced = true;
+	}
+	return replaced;
+}
+#endif
+
+static void ResetTelemetry(void)
+{
+	memset(&telemetry, 0, sizeof(telemetry));
+	telemetry.type = MSG_TELEMETRY;
+	telemetry.latencyMinUs = UINT32_MAX;
+	telemetryStart = xTaskGetTickCount();
+}
+
+static void RecordInference(nnom_model_t *model, uint32_t latencyUs)
+{
+	nnom_layer_t *layer = model->head;
+	uint32_t bin = 0;
+	uint8_t n = 0;
+
+	telemetry.inferences++;
+	telemetry.latencySumUs += latencyUs;
+	if (latencyUs < telemetry.latencyMinUs) {
+		telemetry.latencyMinUs = latencyUs;
+	}
+	if (latencyUs > telemetry.latencyMaxUs) {
+		telemetry.latencyMaxUs = latencyUs;
+	}
+
+	while ((bin < TELEMETRY_HIST_BINS - 1) && (latencyUs >= (1000U << bin))) {
+		bin++;
+	}
+	telemetry.histogram[bin]++;
+
+	// same walk as model_stat()
+	while (layer && (n < TELEMETRY_LAYER_MAX)) {
+		telemetry.layerUs[n++] += layer->stat.time;
+		layer = layer->shortcut;
+	}
+	telemetry.layerCount = n;
+}
+
+static void SendTelemetry(void)
+{
+	TickType_t now = xTaskGetTickCount();
+
+	if (((telemetry.inferences == 0) && (telemetry.cacheHits == 0)) ||
+		((now - telemetryStart) < pdMS_TO_TICKS(TELEMETRY_PERIOD_MS))) {
+		return;
+	}
+
+	// results go first, the record is sent later if the shared buffer is short of space
+	if ((uxQueueMessagesWaiting(resultQueue) != 0) ||
+		(GetEnqueueCapacity(inbound, outbound, sharedBufSize) < sizeof(telemetryBuffer))) {
+		return;
+	}
+
+	telemetry.periodMs = (now - telemetryStart) * portTICK_PERIOD_MS;
+	telemetry.queueDepth = (uint8_t)uxQueueMessagesWaiting(resultQueue);
+	telemetry.heapTotal = configTOTAL_HEAP_SIZE;
+	telemetry.heapHighWater = configTOTAL_HEAP_SIZE - xPortGetMinimumEverFreeHeapSize();
+
+	memcpy(&telemetryBuffer[INTERBUFOVERHEAD], &telemetry, sizeof(telemetry));
+	if (EnqueueData(inbound, outbound, sharedBufSize, &telemetryBuffer[0], sizeof(telemetryBuffer)) == 0) {
+		ResetTelemetry();
+	}
+}
+
+#if PIPELINE_STAGE != PIPELINE_FULL
+static nnom_layer_t *GetLayer(nnom_model_t *model, uint32_t index)
+{
+	nnom_layer_t *layer = model->head;
+
+	while (layer && index--) {
+		layer = layer->shortcut;
+	}
+	return layer;
+}
+#endif
+
+#if PIPELINE_STAGE == PIPELINE_FRONT
+// Activations are only dropped when HL core stops draining the shared buffer, the back stage
+// can not produce a result without all of them. The request is counted as a dropped result.
+static void SendActivation(const IntercoreClassifyReq_t *request, const uint8_t *data, uint16_t size)
+{
+	IntercoreActivation_t *msg = (IntercoreActivation_t *)&activationBuffer[INTERBUFOVERHEAD];
+	TickType_t start;
+	uint16_t length;
+
+	memcpy(&activationBuffer[0], &recvBuffer[0], INTERBUFOVERHEAD);
+	msg->type = MSG_ACTIVATION;
+	msg->seq = request->seq;
+	msg->flags = request->flags;
+	msg->total = size;
+
+	for (uint16_t offset = 0; offset < size; offset += length) {
+		length = ((size - offset) > INTERCORE_ACT_CHUNK) ? INTERCORE_ACT_CHUNK : (size - offset);
+		msg->offset = offset;
+		msg->length = length;
+		memcpy(msg->data, &data[offset], length);
+
+		// wait for HL core to drain the shared buffer
+		FlushPendingResults();
+		start = xTaskGetTickCount();
+		while (GetEnqueueCapacity(inbound, outbound, sharedBufSize) < sizeof(activationBuffer)) {
+			if ((xTaskGetTickCount() - start) >= pdMS_TO_TICKS(ACTIVATION_TIMEOUT_MS)) {
+				droppedResults++;
+				Log_Debug("WARNING: shared buffer full, activations of seq %d dropped\r\n", request->seq);
+				return;
+			}
+			vTaskDelay(1);
+		}
+
+		msg->credits = (uint8_t)uxQueueSpacesAvailable(resultQueue);
+		(void)EnqueueData(inbound, outbound, sharedBufSize, &activationBuffer[0], sizeof(activationBuffer));
+	}
+}
+#endif
+
+#if PIPELINE_STAGE == PIPELINE_BACK
+// Copy a chunk to its place in the tensor, returns 1 once the tensor of a request is complete
+static int AssembleActivation(const IntercoreActivation_t *msg, uint8_t *tensor, uint32_t size)
+{
+	static uint32_t received;
+	static uint8_t seq;
+
+	if ((msg->total != size) || (msg->length > INTERCORE_ACT_CHUNK) || (msg->offset + msg->length > size)) {
+		Log_Debug("WARNING: activations do not match the model, %d bytes\r\n", msg->total);
+		return 0;
+	}
+
+	// chunks arrive in order, a gap means some were lost and the request is given up
+	if (msg->offset == 0) {
+		seq = msg->seq;
+		received = 0;
+	} else if ((msg->seq != seq) || (msg->offset != received)) {
+		Log_Debug("WARNING: incomplete activations for seq %d\r\n", seq);
+		received = 0;
+		return 0;
+	}
+
+	memcpy(&tensor[msg->offset], msg->data, msg->length);
+	received += msg->length;
+
+	return received == size;
+}
+#endif
+
+#if PIPELINE_STAGE != PIPELINE_FRONT
+// Rank the model output and send it to HL core
+static void PostClassification(const int8_t *outputs, uint8_t seq, uint8_t requestFlags, uint32_t time, bool cached)
+{
+	IntercoreClassifyResult_t result;
+	uint32_t topk[INTERCORE_TOPK];
+	uint32_t confidence;
+
+	nnom_topk_q7(outputs, INTERCORE_CLASSES, topk, INTERCORE_TOPK, &confidence);
+
+	if (!(requestFlags & REQ_FLAG_SPECULATIVE)) {
+		Log_Debug("%d, probability: %d%%\r\n", topk[0], confidence);
+		Log_Debug("Time: %d us%s, %d snapshots cancelled\n", time, cached ? " (cached)" : "", cancelledRequests);
+		//model_stat(model);
+	}
+
+	result.type = MSG_CLASSIFY_RESULT;
+	result.seq = seq;
+	result.label = (uint8_t)topk[0];
+	result.flags = (requestFlags & REQ_FLAG_SPECULATIVE) ? RESULT_FLAG_SPECULATIVE : 0;
+	result.confidence = (uint8_t)confidence;
+	memcpy(result.probs, outputs, sizeof(result.probs));
+	for (int i = 0; i < INTERCORE_TOPK; i++) {
+		result.topk[i] = (uint8_t)topk[i];
+	}
+	PostResult(&result);
+}
+#endif
+
+#if PIPELINE_STAGE == PIPELINE_FULL
+static ClassifyJob_t *AllocJob(void)
+{
+	for (int i = 0; i < JOB_NUM; i++) {
+		if (!jobs[i].used) {
+			memset(&jobs[i], 0, sizeof(jobs[i]));
+			jobs[i].used = true;
+			return &jobs[i];
+		}
+	}
+	return NULL;
+}
+
+// A newer request supersedes every snapshot which has not run yet
+static void CancelSnapshots(void)
+{
+	for (int i = 0; i < JOB_NUM; i++) {
+		ClassifyJob_t *j = &jobs[i];
+
+		if (!j->used || !(j->request.flags & REQ_FLAG_SPECULATIVE)) {
+			continue;
+		}
+
+		if (sched->running == &j->job) {
+			j->superseded = true;
+		} else if (sched_cancel(sched, &j->job) == NN_SUCCESS) {
+			CancelRequest(&j->request);
+			j->used = false;
+		}
+	}
+}
+
+static void JobStart(nnom_sched_t *s, nnom_sched_job_t *job)
+{
+	ClassifyJob_t *j = (ClassifyJob_t *)job->user;
+
+	// the input buffer may have been used by another job since this one was submitted
+	memcpy(nnom_input_data, j->request.image, MINST_DATA_SIZE);
+	j->startUs = nnom_us_get();
+}
+
+static nnom_status_t JobRun(nnom_sched_t *s, nnom_sched_job_t *job)
+{
+	ClassifyJob_t *j = (ClassifyJob_t *)job->user;
+
+	// interrupted by a final request which also made this snapshot stale
+	if (j->superseded) {
+		return NN_TIMEOUT;
+	}
+
+	// successive snapshots of one drawing share most of their pixels, only the changed
+	// part of the conv/pool stack is recomputed
+	return (delta != NULL) ? delta_run(delta) : model_run(job->model);
+}
+
+static void JobDone(nnom_sched_t *s, nnom_sched_job_t *job, nnom_status_t status)
+{
+	ClassifyJob_t *j = (ClassifyJob_t *)job->user;
+	uint32_t time = nnom_us_get() - j->startUs;
+
+	telemetry.preemptions += job->preempted;
+	j->used = false;
+
+	if (status != NN_SUCCESS) {
+		if (!j->superseded) {
+			telemetry.deadlineMisses++;
+		}
+		CancelRequest(&j->request);
+		return;
+	}
+
+#if defined(USE_RESULT_CACHE)
+	result_cache_insert(j->key, nnom_output_data);
+#endif
+	RecordInference(job->model, time);
+
+	// a newer request arrived while this snapshot ran to the end, its result is already stale
+	if (j->superseded) {
+		CancelRequest(&j->request);
+		return;
+	}
+
+	// UART is too slow to dump every snapshot, only the final image is printed
+	if (!(j->request.flags & REQ_FLAG_SPECULATIVE)) {
+		//print original image to console
+		print_img(j->request.image);
+	}
+
+	// Send the result back to HL core
+	PostClassification(nnom_output_data, j->request.seq, j->request.flags, time, false);
+}
+
+// Called by the scheduler between jobs and between the layers of a running job
+static void PollRequests(nnom_sched_t *s)
+{
+	IntercoreClassifyReq_t *request = (IntercoreClassifyReq_t *)&recvBuffer[INTERBUFOVERHEAD];
+	ClassifyJob_t *j;
+	uint32_t recvSize;
+
+	while (1) {
+		recvSize = sizeof(recvBuffer);
+		if (DequeueData(outbound, inbound, sharedBufSize, &recvBuffer[0], &recvSize) == -1) {
+			return;
+		}
+
+		if (!IsValidRequest(recvBuffer, recvSize)) {
+			continue;
+		}
+
+		// reply goes to the same component which sent the request
+		memcpy(&sendBuffer[0], &recvBuffer[0], INTERBUFOVERHEAD);
+		memcpy(&telemetryBuffer[0], &recvBuffer[0], INTERBUFOVERHEAD);
+
+		CancelSnapshots();
+
+#if defined(USE_RESULT_CACHE)
+		// a model may be running, the cached output must not go through nnom_output_data
+		int8_t outputs[INTERCORE_CLASSES];
+		uint32_t time = nnom_us_get();
+		uint32_t key = result_cache_hash(request->image, MINST_DATA_SIZE);
+
+		if (result_cache_lookup(key, outputs)) {
+			telemetry.cacheHits++;
+			PostClassification(outputs, request->seq, request->flags, nnom_us_get() - time, true);
+			continue;
+		}
+		telemetry.cacheMisses++;
+#endif
+
+		j = AllocJob();
+		if (j == NULL) {
+			Log_Debug("WARNING: no free job, seq %d cancelled\r\n", request->seq);
+			CancelRequest(request);
+			continue;
+		}
+
+		memcpy(&j->request, request, sizeof(j->request));
+#if defined(USE_RESULT_CACHE)
+		j->key = key;
+#endif
+		j->job.model = model;
+		j->job.start = JobStart;
+		j->job.run = JobRun;
+		j->job.done = JobDone;
+		j->job.user = j;
+		if (request->flags & REQ_FLAG_SPECULATIVE) {
+			j->job.priority = PRIO_SNAPSHOT;
+			j->job.deadline = nnom_ms_get() + SNAPSHOT_DEADLINE_MS;
+		} else {
+			j->job.priority = PRIO_FINAL;
+			j->job.deadline = 0;
+		}
+		(void)sched_submit(s, &j->job);
+	}
+}
+#endif
+
 static void NNTask(void* pParameters)
 {
+#if PIPELINE_STAGE == PIPELINE_FULL
+	model = nnom_model_create();
+
+	sched = sched_create(&model, 1);
+	if (sched == NULL) {
+		Log_Debug("ERROR: sched_create failed\r\n");
+		while (1);
+	}
+	sched->poll = PollRequests;
+
+	// costs ~21KB heap for the cached activations
+	delta = delta_create(model);
+	if (delta == NULL) {
+		Log_Debug("WARNING: delta execution not available, running the full model\r\n");
+	}
+#else
 	nnom_model_t *model;
+	nnom_layer_t *split;
 	uint32_t time;
-	uint32_t predic_label;
-	float prob;
-	uint32_t index;
+	uint32_t recvSize;
+#if PIPELINE_STAGE == PIPELINE_FRONT
+	IntercoreClassifyReq_t *request = (IntercoreClassifyReq_t *)&recvBuffer[INTERBUFOVERHEAD];
+#else
+	IntercoreActivation_t *activation = (IntercoreActivation_t *)&recvBuffer[INTERBUFOVERHEAD];
+#endif
 
 	model = nnom_model_create();
 
-	BufferHeader* outbound, * inbound;
-	uint32_t sharedBufSize = 0;
+	// the back stage reads the front's output from the same buffer the full model would
+	split = GetLayer(model, PIPELINE_SPLIT);
+	if ((split == NULL) || (split->shortcut == NULL)) {
+		Log_Debug("ERROR: model has no layer %d to split at\r\n", PIPELINE_SPLIT);
+		while (1);
+	}
+	Log_Debug("Pipeline stage %d, split after %s\r\n", PIPELINE_STAGE, default_layer_names[split->type]);
+#endif
+
+	resultQueue = xQueueCreate(RESULT_QUEUE_LEN, sizeof(IntercoreClassifyResult_t));
+	if (resultQueue == NULL) {
+		Log_Debug("ERROR: xQueueCreate failed\r\n");
+		while (1);
+	}
 
 	if (GetIntercoreBuffers(&outbound, &inbound, &sharedBufSize) == -1) {
 		Log_Debug("ERROR: GetIntercoreBuffers failed\r\n");
 		while (1);
 	}
 
-	uint32_t recvSize = MINST_DATA_SIZE + INTERBUFOVERHEAD;
+	ResetTelemetry();
 
 	while (1) {
-		
+#if PIPELINE_STAGE == PIPELINE_FULL
+		// requests are picked up by PollRequests() while the queue drains
+		(void)sched_run(sched);
+
+		// HL core may have drained the shared buffer meanwhile
+		FlushPendingResults();
+		SendTelemetry();
+#else
 		// waiting for incoming data
+		recvSize = sizeof(recvBuffer);
 		if (DequeueData(outbound, inbound, sharedBufSize, &recvBuffer[0], &recvSize) == -1) {
+			// HL core may have drained the shared buffer meanwhile
+			FlushPendingResults();
+			SendTelemetry();
 			continue;
 		}
 
-		time = nnom_ms_get();
-		memcpy(nnom_input_data, (int8_t*)&recvBuffer[INTERBUFOVERHEAD], MINST_DATA_SIZE);
-		(void)nnom_predict(model, &predic_label, &prob);
-		time = nnom_ms_get() - time;
+		if (!IsValidRequest(recvBuffer, recvSize)) {
+			continue;
+		}
 
-		//print original image to console
-		print_img((int8_t*)&recvBuffer[INTERBUFOVERHEAD]);
+		// reply goes to the same component which sent the request
+		memcpy(&sendBuffer[0], &recvBuffer[0], INTERBUFOVERHEAD);
+		memcpy(&telemetryBuffer[0], &recvBuffer[0], INTERBUFOVERHEAD);
 
-		Log_Debug("%d, probability: %d%%\r\n", predic_label, (int)(prob * 100));
-		Log_Debug("Time: %d ms\n", time);
-		//model_stat(model);
+#if PIPELINE_STAGE == PIPELINE_BACK
+		if (!AssembleActivation(activation, split->out->mem->blk, tensor_size(split->out->tensor))) {
+			continue;
+		}
+
+		time = nnom_us_get();
+		(void)model_run_range(model, split->shortcut, NULL);
+		time = nnom_us_get() - time;
+		RecordInference(model, time);
+
+		PostClassification(nnom_output_data, activation->seq, activation->flags, time, false);
+#else
+		(void)CoalesceRequests();
+
+		// a snapshot which went stale while running is cancelled, the newer request runs instead
+		do {
+			time = nnom_us_get();
+			memcpy(nnom_input_data, request->image, MINST_DATA_SIZE);
+			(void)model_run_to(model, split);
+			time = nnom_us_get() - time;
+			RecordInference(model, time);
+		} while (CoalesceRequests());
+
+		if (!(request->flags & REQ_FLAG_SPECULATIVE)) {
+			print_img(request->image);
+			Log_Debug("Front stage time: %d us, %d snapshots cancelled\n", time, cancelledRequests);
+		}
 
-		// Send the result back to HL core
-		recvBuffer[INTERBUFOVERHEAD] = (uint8_t)predic_label;
-		EnqueueData(inbound, outbound, sharedBufSize, &recvBuffer[0], INTERBUFOVERHEAD + 1);
+		SendActivation(request, split->out->mem->blk, (uint16_t)tensor_size(split->out->tensor));
+#endif
+#endif
 	}
 }
 
@@ -161,6 +161,35 @@ int EnqueueData(BufferHeader *inbound, BufferHeader *outbound, uint32_t bufSize,
     return 0;
 }
 
+uint32_t GetEnqueueCapacity(BufferHeader *inbound, BufferHeader *outbound, uint32_t bufSize)
+{
+    uint32_t remoteReadPosition = inbound->readPosition;
+    uint32_t localWritePosition = outbound->writePosition;
+
+    if (remoteReadPosition >= bufSize) {
+        return 0;
+    }
+
+    // Same free space calculation as EnqueueData().
+    uint32_t availSpace;
+    if (remoteReadPosition <= localWritePosition) {
+        availSpace = remoteReadPosition - localWritePosition + bufSize;
+    } else {
+        availSpace = remoteReadPosition - localWritePosition;
+    }
+
+    // The block size word must not be split by the end of the buffer.
+    if (bufSize - localWritePosition < sizeof(uint32_t)) {
+        return 0;
+    }
+
+    if (availSpace < sizeof(uint32_t) + RINGBUFFER_ALIGNMENT) {
+        return 0;
+    }
+
+    return availSpace - sizeof(uint32_t) - RINGBUFFER_ALIGNMENT;
+}
+
 int DequeueData(BufferHeader *outbound, BufferHeader *inbound, uint32_t bufSize, void *dest,
                 uint32_t *dataSize)
 {
@@ -60,6 +60,20 @@ int GetIntercoreBuffers(BufferHeader **outbound, BufferHeader **inbound, uint32_
 int EnqueueData(BufferHeader *inbound, BufferHeader *outbound, uint32_t bufSize, const void *src,
                 uint32_t dataSize);
 
+/// <summary>
+/// Get the largest block which <see cref="EnqueueData" /> can currently add to the shared buffer.
+/// Callers use this to hold data back instead of failing the enqueue.
+/// </summary>
+/// <param name="inbound">The inbound buffer, as obtained from <see cref="GetIntercoreBuffers" />.
+/// </param>
+/// <param name="outbound">The outbound buffer, as obtained from <see cref="GetIntercoreBuffers" />.
+/// </param>
+/// <param name="bufSize">
+/// The total buffer size, as obtained from <see cref="GetIntercoreBuffers" />.
+/// </param>
+/// <returns>Maximum data size in bytes, 0 if no block fits.</returns>
+uint32_t GetEnqueueCapacity(BufferHeader *inbound, BufferHeader *outbound, uint32_t bufSize);
+
 /// <summary>
 /// Remove data from the shared buffer, which has been written by the high-level application.
 /// </summary>
@@ -0,0 +1,73 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "nnom.h"
+
+// SumPool has no computational buffer. Right after the input every block is still in use
+// when it is compiled, which is where an empty buffer used to break the memory plan.
+
+#define H	8
+#define W	8
+#define C	4
+#define K	2
+
+static int8_t input[H * W * C];
+static int8_t output[(H / K) * (W / K) * C];
+static int8_t expect[(H / K) * (W / K) * C];
+
+// the sums of the 2x2 windows, shifted by the same dynamic shift as local_sumpool_q7_HWC()
+static void reference(void)
+{
+	int32_t sum[(H / K) * (W / K) * C];
+	int32_t max_abs = 0, shift = 0;
+
+	for (int y = 0; y < H / K; y++)
+		for (int x = 0; x < W / K; x++)
+			for (int c = 0; c < C; c++)
+			{
+				int32_t s = 0;
+				for (int ky = 0; ky < K; ky++)
+					for (int kx = 0; kx < K; kx++)
+						s += input[((y * K + ky) * W + x * K + kx) * C + c];
+				sum[(y * (W / K) + x) * C + c] = s;
+				max_abs = abs(s) > max_abs ? abs(s) : max_abs;
+			}
+	while (127 * (1 + shift) < max_abs)
+		shift++;
+	for (int i = 0; i < (int)sizeof(expect); i++)
+		expect[i] = (int8_t)(sum[i] >> shift);
+}
+
+int main(int argc, char* argv[])
+{
+	nnom_model_t *model;
+	nnom_layer_t *in, *x;
+
+	for (int i = 0; i < (int)sizeof(input); i++)
+		input[i] = (int8_t)((i * 37) % 200 - 100);
+	reference();
+
+	model = new_model(NULL);
+	in = Input(shape(H, W, C), input);
+	x = model->hook(SumPool(kernel(K, K), stride(K, K), PADDING_VALID), in);
+	x = model->hook(Output(shape(H / K, W / K, C), output), x);
+	if (model_compile(model, in, x) != NN_SUCCESS || model_run(model) != NN_SUCCESS)
+	{
+		printf("FAIL: Input -> SumPool does not run\n");
+		return 1;
+	}
+	model_delete(model);
+
+	if (memcmp(output, expect, sizeof(output)) != 0)
+	{
+		printf("FAIL: Input -> SumPool output differs from the reference\n");
+		return 1;
+	}
+	printf("PASS: Input -> SumPool\n");
+	return 0;
+}
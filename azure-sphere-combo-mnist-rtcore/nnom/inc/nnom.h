@@ -41,7 +41,8 @@ typedef enum
 	NN_SINGULAR = -5,		/**< Generated by matrix inversion if the input matrix is singular and cannot be inverted. */
 	NN_TEST_FAILURE = -6,   /**< Test Failed  */
 	NN_NO_MEMORY = -7,
-	NN_MORE_TODO = -8
+	NN_MORE_TODO = -8,
+	NN_TIMEOUT = -9			/**< Deadline passed before the job could run */
 } nnom_status_t;
 
 typedef enum
@@ -173,6 +174,22 @@ typedef struct _nnom_weights
 	size_t shift;
 } nnom_weight_t;
 
+// block sparse weights, the non-zero blocks of 4 consecutive weights of each output along its input
+typedef struct _nnom_sparse_weights
+{
+	const void *p_value;		// q7 values of the blocks, 4 each
+	const uint16_t *block_idx;	// where each block starts in the input, in units of 4
+	const uint32_t *row_ptr;	// the blocks of output o are row_ptr[o] to row_ptr[o+1]-1
+} nnom_sparse_weight_t;
+
+// 4-bit weights, two per byte with the first in the low nibble, each output padded to 8 weights
+typedef struct _nnom_int4_weights
+{
+	const void *p_value;
+	const uint8_t *bias_shift;		// left shift of each output's bias, NULL to use the layer's
+	const uint8_t *output_shift;	// right shift of each output, NULL to use the layer's
+} nnom_int4_weight_t;
+
 typedef struct _nnom_bias
 {
 	const void *p_value;
@@ -269,6 +286,8 @@ typedef struct _nnom_model nnom_model_t;
 
 #include "nnom_tensor.h"
 #include "nnom_layers.h"
+#include "nnom_delta.h"
+#include "nnom_sched.h"
 #include "nnom_utils.h"
 
 // models, I dont want to make model class as a child of layer class yet
@@ -324,6 +343,10 @@ nnom_status_t sequencial_compile(nnom_model_t *m);
 nnom_status_t model_compile(nnom_model_t *m, nnom_layer_t *input, nnom_layer_t *output);
 // run a prediction
 nnom_status_t model_run(nnom_model_t *m);
+// run until end_layer (included), NULL to run all layers
+nnom_status_t model_run_to(nnom_model_t *m, nnom_layer_t *end_layer);
+// run from start_layer until end_layer (both included), for splitting a model across cores
+nnom_status_t model_run_range(nnom_model_t *m, nnom_layer_t *start_layer, nnom_layer_t *end_layer);
 // delete model. 
 void model_delete(nnom_model_t *m);
 
@@ -0,0 +1,62 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __NNOM_DELTA_H__
+#define __NNOM_DELTA_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "nnom.h"
+
+// Incremental (delta) execution.
+// The Conv2D / MaxPool / activation / BatchNorm layers at the front of a model keep their outputs in
+// private buffers between runs. A delta run compares the new input with the last one,
+// propagates the changed rectangle through each layer's receptive field and only
+// recomputes the outputs inside it. Everything after the first other layer (Dense, ...)
+// runs in full as usual.
+
+// a rectangle of a HWC tensor, [x0, x1) x [y0, y1). empty when x0 >= x1 or y0 >= y1
+typedef struct _nnom_delta_rect_t
+{
+	int16_t x0, y0, x1, y1;
+} nnom_delta_rect_t;
+
+typedef struct _nnom_delta_layer_t
+{
+	nnom_layer_t *layer;
+	nnom_mem_block_t block;	   // private buffer the cached output lives in (unused by in-place layers)
+	nnom_mem_block_t *shared;  // the block given by the compiler, restored on delete
+	nnom_delta_rect_t dirty;   // outputs recomputed by the last delta run
+} nnom_delta_layer_t;
+
+typedef struct _nnom_delta_t
+{
+	nnom_model_t *model;
+	nnom_delta_layer_t *layers; // Input layer first, then the cached stack in running order
+	uint32_t layer_num;
+	nnom_layer_t *rest;			// first layer which is always run in full
+	bool valid;					// caches hold the outputs of the last input
+
+	// stat
+	uint32_t run_count;
+	uint32_t full_count;		// runs with no usable cache or a fully changed input
+} nnom_delta_t;
+
+// create delta execution on a compiled HWC model. returns NULL when the model does not start
+// with a cacheable stack (Input followed by at least one Conv2D / MaxPool) or out of memory
+nnom_delta_t *delta_create(nnom_model_t *m);
+
+// run the model with the data in its input buffer, recomputing only what has changed
+nnom_status_t delta_run(nnom_delta_t *d);
+
+// the next delta_run() recomputes everything.
+// must be called if the model has been run by model_run() since the last delta_run()
+void delta_invalidate(nnom_delta_t *d);
+
+// give the model its original buffers back and free the caches
+void delta_delete(nnom_delta_t *d);
+
+#endif
@@ -31,6 +31,8 @@ typedef struct _nnom_conv2d_layer_t
 	nnom_layer_t super;
 	nnom_shape_t kernel;
 	nnom_shape_t stride;
+	nnom_shape_t dilation;
+	nnom_shape_t upsample;							// nearest up sampling of the input by a fused UpSample, 1 for none
 	int8_t output_shift;
 	int8_t bias_shift;
 	nnom_shape_t pad;
@@ -38,6 +40,9 @@ typedef struct _nnom_conv2d_layer_t
 	uint32_t filter_mult; 							// filter size (for conv) or multilplier (for depthwise)
 	const nnom_weight_t *weights;
 	const nnom_bias_t *bias;
+	const nnom_weight_t *winograd;					// 3x3 stride 1 weights transformed for F(2x2,3x3), or NULL
+	const nnom_sparse_weight_t *sparse;				// block sparse weights, or NULL
+	const nnom_int4_weight_t *int4;					// 4-bit weights, or NULL
 } nnom_conv2d_layer_t;
 
 typedef struct _nnom_dense_layer_t
@@ -46,16 +51,32 @@ typedef struct _nnom_dense_layer_t
 	size_t output_unit;
 	const nnom_weight_t *weights;
 	const nnom_bias_t *bias;
+	const nnom_sparse_weight_t *sparse;		// block sparse weights, or NULL
+	const nnom_int4_weight_t *int4;			// 4-bit weights, or NULL
 	int8_t output_shift;
 	int8_t bias_shift;
 
 } nnom_dense_layer_t;
 
+// batch normalization, a scale and an offset for each channel
+typedef struct _nnom_batchnorm_layer_t
+{
+	nnom_layer_t super;
+	const nnom_weight_t *weights;			// scale of each channel
+	const nnom_bias_t *bias;				// offset of each channel
+	int8_t output_shift;
+	int8_t bias_shift;
+	nnom_layer_t *folded;					// the Conv2D/Dense it is folded into, or NULL
+	nnom_weight_t fold_w;					// the new weights and bias of that layer, in RAM
+	nnom_bias_t fold_b;
+} nnom_batchnorm_layer_t;
+
 // zero padding
 typedef struct _nnom_zero_padding_layer_t
 {
 	nnom_layer_t super;
 	nnom_border_t pad;
+	nnom_layer_t *fused;					// the Conv2D that pads the input itself, or NULL
 } nnom_zero_padding_layer_t;
 
 // Cropping, same as zeropadding
@@ -146,6 +167,7 @@ typedef struct _nnom_upsample_layer_t
 {
 	nnom_layer_t super;
 	nnom_shape_t kernel;
+	nnom_layer_t *fused;					// the Conv2D that up samples the input itself, or NULL
 } nnom_upsample_layer_t;
 
 // IO layer
@@ -167,6 +189,7 @@ typedef struct _nnom_concat_layer
 nnom_shape_t shape(size_t h, size_t w, size_t c);
 nnom_shape_t kernel(size_t h, size_t w);
 nnom_shape_t stride(size_t h, size_t w);
+nnom_shape_t dilation(size_t h, size_t w);
 nnom_border_t border(size_t top, size_t bottom, size_t left, size_t right);
 nnom_qformat_t qformat(int8_t m, int8_t n);
 size_t shape_size(nnom_shape_t* s);
@@ -218,6 +241,46 @@ nnom_layer_t *Concat(int8_t axis);
 nnom_layer_t *Conv2D(uint32_t filters, nnom_shape_t k, nnom_shape_t s, nnom_padding_t pad,
 					 const nnom_weight_t *w, const nnom_bias_t *b);
 
+// run a 3x3 stride 1 Conv2D with Winograd F(2x2,3x3), w is exported by nnom_utils.py.
+// ignored when the layer does not qualify or has less than NNOM_WINOGRAD_MIN_CH in/out channels
+#ifndef NNOM_WINOGRAD_MIN_CH
+#define NNOM_WINOGRAD_MIN_CH	(8)
+#endif
+nnom_layer_t *conv2d_winograd(nnom_layer_t *layer, const nnom_weight_t *w);
+
+// run a pruned Conv2D (HWC) or Dense with block sparse weights, w is exported by nnom_utils.py.
+// p_value of the weights given to Conv2D()/Dense() can then be NULL. If it is not, the dense kernel
+// is used instead when more than NNOM_SPARSE_MAX_DENSITY percent of the blocks are non-zero
+#ifndef NNOM_SPARSE_MAX_DENSITY
+#define NNOM_SPARSE_MAX_DENSITY	(50)
+#endif
+nnom_layer_t *conv2d_sparse(nnom_layer_t *layer, const nnom_sparse_weight_t *w);
+nnom_layer_t *dense_sparse(nnom_layer_t *layer, const nnom_sparse_weight_t *w);
+
+// run a Conv2D (HWC) or Dense with 4-bit weights, w is exported by nnom_utils.py.
+// p_value of the weights given to Conv2D()/Dense() is then NULL, their shift is used when w has no
+// per channel shifts. Takes the place of the sparse and Winograd weights
+nnom_layer_t *conv2d_int4(nnom_layer_t *layer, const nnom_int4_weight_t *w);
+nnom_layer_t *dense_int4(nnom_layer_t *layer, const nnom_int4_weight_t *w);
+
+// dilate the kernel of a Conv2D or DW_Conv2D, its taps are then d.h/d.w pixels apart.
+// Works with the q7, sparse and 4-bit weights, Winograd is dropped
+nnom_layer_t *conv2d_dilation(nnom_layer_t *layer, nnom_shape_t d);
+
+// batch normalization, w and b are the scale and offset of each channel.
+// Folded into the weights of the Conv2D/Dense right before it when nothing else uses that output,
+// the new weights are kept in RAM if they take at most NNOM_BATCHNORM_FOLD_MAX bytes.
+#ifndef NNOM_BATCHNORM_FOLD_MAX
+#define NNOM_BATCHNORM_FOLD_MAX	(16*1024)
+#endif
+nnom_layer_t *BatchNorm(const nnom_weight_t *w, const nnom_bias_t *b);
+
+// a ZeroPadding or UpSample followed only by a Conv2D (HWC) does not make its output, the Conv2D
+// reads the input with the padding or the up sampling on the fly. 0 keeps them as separate layers
+#ifndef NNOM_FUSE_CONV_INPUT
+#define NNOM_FUSE_CONV_INPUT	(1)
+#endif
+
 // depthwise_convolution
 nnom_layer_t *DW_Conv2D(uint32_t multiplier, nnom_shape_t k, nnom_shape_t s, nnom_padding_t pad,
 						const nnom_weight_t *w, const nnom_bias_t *b);
@@ -246,8 +309,10 @@ nnom_status_t default_build(nnom_layer_t* layer);
 nnom_status_t input_build(nnom_layer_t* layer);
 
 nnom_status_t conv2d_build(nnom_layer_t* layer);
+nnom_layer_t *conv2d_fuse_input(nnom_layer_t* layer);
 nnom_status_t dw_conv2d_build(nnom_layer_t* layer);
 nnom_status_t dense_build(nnom_layer_t* layer);
+nnom_status_t batchnorm_build(nnom_layer_t* layer);
 nnom_status_t rnn_build(nnom_layer_t* layer);
 
 nnom_status_t upsample_build(nnom_layer_t* layer);
@@ -271,6 +336,7 @@ nnom_status_t default_run(nnom_layer_t* layer);  // simply copy data from input
 nnom_status_t dw_conv2d_run(nnom_layer_t* layer);
 nnom_status_t conv2d_run(nnom_layer_t* layer);
 nnom_status_t dense_run(nnom_layer_t* layer);
+nnom_status_t batchnorm_run(nnom_layer_t* layer);
 nnom_status_t rnn_run(nnom_layer_t* layer);
 nnom_status_t cell_simple_rnn_run(nnom_layer_t* layer);
 
@@ -284,6 +350,9 @@ nnom_status_t softmax_run(nnom_layer_t* layer);
 nnom_status_t maxpool_run(nnom_layer_t* layer);
 nnom_status_t avgpool_run(nnom_layer_t* layer);
 nnom_status_t sumpool_run(nnom_layer_t* layer);
+nnom_status_t global_maxpool_run(nnom_layer_t* layer);
+nnom_status_t global_avgpool_run(nnom_layer_t* layer);
+nnom_status_t global_sumpool_run(nnom_layer_t* layer);
 
 nnom_status_t concat_run(nnom_layer_t* layer);
 nnom_status_t add_run(nnom_layer_t* layer);
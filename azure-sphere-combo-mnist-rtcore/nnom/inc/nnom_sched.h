@@ -0,0 +1,82 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __NNOM_SCHED_H__
+#define __NNOM_SCHED_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "nnom.h"
+
+// Scheduler for several compiled models on one core.
+// Only one model runs at a time, so all of them share one activation arena sized for the
+// largest. Each job has a priority and a deadline. The most urgent job runs first. When a
+// more urgent job arrives during a run, it takes over at the next layer boundary. The
+// interrupted job restarts from its first layer later, because the arena has been reused.
+
+#define NNOM_SCHED_MODEL_MAX	(4)
+
+typedef struct _nnom_sched_t nnom_sched_t;
+typedef struct _nnom_sched_job_t nnom_sched_job_t;
+
+typedef struct _nnom_sched_job_t
+{
+	nnom_model_t *model;
+	uint8_t priority;	// larger runs first
+	uint32_t deadline;	// nnom_ms_get() time, earlier runs first within a priority. 0 = none
+						// a job whose deadline has passed before it starts is not run
+
+	// called before each (re)start, e.g. to fill the input buffer. can be NULL
+	void (*start)(nnom_sched_t *s, nnom_sched_job_t *job);
+	// runs the model, model_run() when NULL. must honour the model's layer_callback
+	nnom_status_t (*run)(nnom_sched_t *s, nnom_sched_job_t *job);
+	// result is NN_SUCCESS, NN_TIMEOUT when the deadline passed before it ran, or an error
+	void (*done)(nnom_sched_t *s, nnom_sched_job_t *job, nnom_status_t result);
+	void *user;
+
+	// set by the scheduler
+	uint32_t preempted;	// times the job was interrupted and started over
+	nnom_sched_job_t *next;
+} nnom_sched_job_t;
+
+typedef struct _nnom_sched_t
+{
+	nnom_model_t *models[NNOM_SCHED_MODEL_MAX];
+	nnom_status_t (*model_callback[NNOM_SCHED_MODEL_MAX])(nnom_model_t *m, nnom_layer_t *layer); // chained after each layer
+	uint32_t model_num;
+	void *arena;
+	size_t arena_size;
+
+	nnom_sched_job_t *queue;	// most urgent first
+	nnom_sched_job_t *running;
+
+	// called between layers and jobs, to submit jobs which arrived meanwhile. can be NULL
+	void (*poll)(nnom_sched_t *s);
+	void *user;
+
+	// stat
+	uint32_t run_count;
+	uint32_t preempt_count;
+	uint32_t miss_count;		// jobs dropped or finished after their deadline
+} nnom_sched_t;
+
+// take over the activation memory of compiled models. their own buffers are freed and
+// all of them use one arena of the size of the largest. NULL when out of memory
+nnom_sched_t *sched_create(nnom_model_t **models, uint32_t num);
+
+// queue a job, it must not be queued already
+nnom_status_t sched_submit(nnom_sched_t *s, nnom_sched_job_t *job);
+
+// take a job off the queue before it runs, returns NN_ARGUMENT_ERROR if it is not queued
+nnom_status_t sched_cancel(nnom_sched_t *s, nnom_sched_job_t *job);
+
+// run jobs until the queue is empty
+nnom_status_t sched_run(nnom_sched_t *s);
+
+// give every model its own buffers back and free the arena
+void sched_delete(nnom_sched_t *s);
+
+#endif
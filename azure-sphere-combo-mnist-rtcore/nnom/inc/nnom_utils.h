@@ -74,6 +74,14 @@ void prediction_summary(nnom_predict_t *pre);
 // return the predicted label
 // return NN_ARGUMENT_ERROR if parameter error
 nnom_status_t nnom_predict(nnom_model_t *m, uint32_t *label, float *prob);
+// same, but the model runs through delta execution, only recomputing what the new input changed
+nnom_status_t nnom_predict_delta(nnom_delta_t *d, uint32_t *label, float *prob);
+
+// top-k without float math. top_k[] receives the k best labels, best first. 
+// confidence is the best output in percent of the sum of all positive outputs
+nnom_status_t nnom_predict_topk(nnom_model_t *m, uint32_t *top_k, uint32_t k, uint32_t *confidence);
+// the same ranking on an output vector which is already there (e.g. copied out by the Output layer)
+void nnom_topk_q7(const int8_t *output, uint32_t size, uint32_t *top_k, uint32_t k, uint32_t *confidence);
 
 void model_stat(nnom_model_t *m);
 
@@ -0,0 +1,29 @@
+#!/usr/bin/env python
+
+'''
+    Writes the q7 sigmoid and tanh tables in nnom_local.h, one table of 256 for each
+    integer width of the input, from Q0.7 to Q7.0. The output is always Q0.7.
+    python nnom_act_tables.py > tables.txt
+'''
+
+import math
+
+def q7(x, lo=-128, hi=127):
+    return min(max(int(math.floor(x * 128 + 0.5)), lo), hi)
+
+def table(name, f):
+    print('static const q7_t %s[8][256] = {' % name)
+    for int_width in range(8):
+        print('    // Q%d.%d' % (int_width, 7 - int_width))
+        print('    {')
+        # indexed by the input as uint8_t, so 0 to 127 then -128 to -1
+        values = [q7(f((i if i < 128 else i - 256) / 2.0 ** (7 - int_width))) for i in range(256)]
+        for row in range(0, 256, 16):
+            print('        ' + ' '.join(['0x%02x,' % (v & 0xff) for v in values[row:row + 16]]))
+        print('    },')
+    print('};')
+
+if __name__ == '__main__':
+    table('nnom_sigmoid_table_q7', lambda x: 1 / (1 + math.exp(-x)))
+    print('')
+    table('nnom_tanh_table_q7', math.tanh)
@@ -125,6 +125,7 @@ def is_shift_layer(layer):
         ('add' in layer.name and 'zero' not in layer.name) or # the name, zero_padding contains 'add'
         'subtract' in layer.name or
         'multiply' in layer.name or
+        ('batch_normalization' in layer.name and not is_fused_bn(layer)) or
        ('activation' in layer.name and layer.get_config()['activation'] == 'softmax')or
        ('activation' in layer.name and layer.get_config()['activation'] == 'sigmoid') or
        ('activation' in layer.name and layer.get_config()['activation'] == 'tanh')
@@ -132,6 +133,75 @@ def is_shift_layer(layer):
         return True
     return False
 
+def is_winograd_layer(layer, format='hwc', winograd=True, min_ch=8):
+    '''
+    3x3 stride 1 conv2d which runs faster with Winograd F(2x2,3x3), see conv2d_winograd()
+    winograd: True for all such layers, False for none, or a list of layer names. The transformed
+    weights take 32 bytes per in/out channel pair on top of the 9 of the q7 kernel.
+    min_ch must not be smaller than NNOM_WINOGRAD_MIN_CH
+    '''
+    if(winograd is False or 'chw' in format or
+       'conv2d' not in layer.name or 'depthwise' in layer.name):
+        return False
+    if(winograd is not True and layer.name not in winograd):
+        return False
+    cfg = layer.get_config()
+    return (tuple(cfg['kernel_size']) == (3, 3) and
+            tuple(cfg['strides']) == (1, 1) and
+            tuple(cfg.get('dilation_rate', (1, 1))) == (1, 1) and
+            int(layer.input.shape[-1]) >= min_ch and
+            cfg['filters'] >= min_ch)
+
+def convert_to_winograd_weights(weights):
+    '''
+    Transform quantised HWC conv2d weights (out_ch, 3, 3, in_ch) for local_convolve_HWC_q7_winograd()
+    U = G g G^T, G = [2 0 0; 1 1 1; 1 -1 1; 0 0 2] is twice the textbook one so U stays integer.
+    Returns int16 in (out_ch, 16, in_ch)
+    '''
+    G = np.array([[2, 0, 0], [1, 1, 1], [1, -1, 1], [0, 0, 2]])
+    U = np.einsum('ik,oklc,jl->oijc', G, weights.astype(np.int32), G)
+    return np.reshape(U, (weights.shape[0], 16, weights.shape[3])).astype(np.int16)
+
+def is_sparse_layer(layer, format='hwc'):
+    ''' layers with a block sparse kernel, see conv2d_sparse() and dense_sparse(). Conv2D only in HWC '''
+    if('dense' in layer.name):
+        return True
+    return 'conv2d' in layer.name and 'depthwise' not in layer.name and 'chw' not in format
+
+def convert_to_sparse_weights(weights):
+    '''
+    Block sparse format of quantised weights (out, ...) for the sparse kernels in nnom_local.c.
+    The weights of each output are cut in blocks of 4 along the input (zero padded), only the
+    non-zero blocks are kept. Returns (values, block_idx, row_ptr, density), density is the
+    fraction of non-zero blocks. Every block costs 4 values and 2 bytes of index.
+    '''
+    w = np.reshape(weights, (weights.shape[0], -1))
+    w = np.pad(w, ((0, 0), (0, -w.shape[1] % 4)), 'constant')
+    blocks = np.reshape(w, (w.shape[0], -1, 4))
+    mask = np.any(blocks != 0, axis=2)
+    values = blocks[mask].flatten()
+    block_idx = np.nonzero(mask)[1]
+    row_ptr = np.concatenate(([0], np.cumsum(np.sum(mask, axis=1))))
+    return values, block_idx, row_ptr, float(np.mean(mask))
+
+def is_int4_layer(layer, format='hwc', int4=False):
+    '''
+    layers with 4-bit weights, see conv2d_int4() and dense_int4(). Conv2D only in HWC
+    int4: True for all Dense and Conv2D, False for none, or a list of layer names.
+    '''
+    if(int4 is False or not is_sparse_layer(layer, format)):
+        return False
+    return int4 is True or layer.name in int4
+
+def convert_to_int4_weights(weights):
+    '''
+    Pack quantised 4-bit weights (out, ...) for the int4 kernels in nnom_local.c. The weights of each
+    output are padded to a multiple of 8, two weights per byte with the first in the low nibble.
+    '''
+    w = np.reshape(weights, (weights.shape[0], -1)).astype(np.int8)
+    w = np.pad(w, ((0, 0), (0, -w.shape[1] % 8)), 'constant')
+    return ((w[:, 1::2] << 4) | (w[:, 0::2] & 0xF)).astype(np.int8).flatten()
+
 def is_shift_fixed(layer):
     ''' layer which shift to a fixed value'''
     #FIXME: add more which will change the output shift
@@ -145,6 +215,32 @@ def is_shift_fixed(layer):
         return True
     return  False
 
+def is_fused_bn(layer):
+    ''' batch normalization right after a convolution, fuse_bn_to_conv() puts it in the kernel '''
+    return ('batch_normalization' in layer.name and
+            'conv' in layer._inbound_nodes[0].inbound_layers[0].name)
+
+def layer_kernel_bias(layer):
+    '''
+    Returns the (name, values) of the kernel and the bias of a layer. For a batch normalization
+    which is not fused these are the scale and the offset of each channel, run by BatchNorm()
+    '''
+    if ('batch_normalization' in layer.name):
+        w = layer.get_weights()
+        gamma = w.pop(0) if layer.scale else 1.0
+        beta = w.pop(0) if layer.center else 0.0
+        mean, variance = w
+        scale = gamma / np.sqrt(variance + layer.epsilon)
+        return [(layer.name + '/kernel:0', scale), (layer.name + '/bias:0', beta - mean * scale)]
+    variables = []
+    for var in layer.weights:
+        var_name = str(var.name)
+        if("kernel" in var_name ):
+            variables.append((var_name, layer.get_weights()[0]))
+        elif("bias" in var_name):
+            variables.append((var_name, layer.get_weights()[1]))
+    return variables
+
 def fuse_bn_to_conv(layer):
     # try to fuse BN layer to convolutional
     if ('conv' in layer.name) and \
@@ -202,8 +298,19 @@ def fuse_bn_to_conv(layer):
         # after that, the model will be destroyed.. need a better way to pass the new weight
         layer.set_weights([c_w, c_b])
 
-def generate_weights(model, name='weights.h', format='hwc', shift_list=None):
-    # Quantize weights to 8-bits using (min,max) and write to file
+def generate_weights(model, name='weights.h', format='hwc', shift_list=None, winograd=True, sparse=0.5,
+                     int4=False, int4_per_channel=True):
+    '''
+    Quantize weights to 8-bits using (min,max) and write to file
+    sparse: kernels whose fraction of non-zero blocks is at most this are written in block sparse
+    format only, see convert_to_sparse_weights(). 0 to keep all kernels dense.
+    int4: kernels quantised to 4 bits instead, see is_int4_layer(). With int4_per_channel each
+    output channel gets its own shift, the kernel shift is then the smallest of them.
+    Returns the names of the layers with sparse kernels, and a dict of the 4-bit layers with the
+    extra shift of each channel (None when the shift is per layer).
+    '''
+    sparse_layers = []
+    int4_layers = {}
     f = open(name, 'w')
     f.write('#include "nnom.h"\n\n')
     f.close()
@@ -212,11 +319,9 @@ def generate_weights(model, name='weights.h', format='hwc', shift_list=None):
         if (not layer.weights):
             continue
 
-        # before merging bn layer, check if the bn is "legally" after Conv
-        if('batch_normalization' in layer.name) and \
-            ('conv' not in layer._inbound_nodes[0].inbound_layers[0].name):
-            raise  Exception('Currently only support batch_normalization after conv', layer.name,
-                            layer._inbound_nodes[0].inbound_layers[0].name)
+        # bn layer after Conv is merged to it, the others are written as scale and offset
+        if(is_fused_bn(layer)):
+            continue
 
         # try to fuse BN layer to convolutional
         if ('conv' in layer.name) and \
@@ -226,16 +331,11 @@ def generate_weights(model, name='weights.h', format='hwc', shift_list=None):
         # generate weights and bias now
         weight_dec_shift = 0
         print('weights for layer', layer.name)
-        for var in layer.weights:
-            var_name = str(var.name)
+        for var_name, var_values in layer_kernel_bias(layer):
             if("kernel" in var_name ):
-                var_values = layer.get_weights()[0] # weight
                 print("  weight:", var_name)
-            elif("bias" in var_name):
-                var_values = layer.get_weights()[1] # bias
-                print("  bias: ",var_name)
             else:
-                continue
+                print("  bias: ",var_name)
 
             print("  original shape: ", var_values.shape)
             min_value = np.min(var_values)
@@ -243,6 +343,15 @@ def generate_weights(model, name='weights.h', format='hwc', shift_list=None):
 
             int_bits = int(np.ceil(np.log2(max(abs(min_value), abs(max_value)))))
             dec_bits = 7 - int_bits
+            # 4-bit kernel, output channels are on the last axis
+            ch_dec_bits = None
+            if ("kernel" in var_name and is_int4_layer(layer, format, int4)):
+                ch_dec_bits = np.full(var_values.shape[-1], 3 - int_bits)
+                if(int4_per_channel):
+                    ch_max = np.max(np.abs(np.reshape(var_values, (-1, var_values.shape[-1]))), axis=0)
+                    ch_max = np.where(ch_max > 0, ch_max, max(abs(min_value), abs(max_value)))
+                    ch_dec_bits = 3 - np.ceil(np.log2(ch_max)).astype(int)
+                dec_bits = int(np.min(ch_dec_bits))
             print("  dec bit", dec_bits)
             bSameAsKernel = False
             if(is_shift_layer(layer)):
@@ -264,12 +373,14 @@ def generate_weights(model, name='weights.h', format='hwc', shift_list=None):
                         dec_bits = weight_dec_shift	
                 print("  new dec bit", dec_bits)
 
-            # convert to [-128,128) or int8
-            var_values = np.round(var_values * 2 ** dec_bits)
+            # convert to [-128,128) or int8, [-8,8) for 4-bit
+            if (ch_dec_bits is not None):
+                var_values = np.clip(np.round(var_values * 2.0 ** ch_dec_bits), -8, 7)
+                int4_layers[layer.name] = list(ch_dec_bits - dec_bits) if int4_per_channel else None
+            else:
+                var_values = np.round(var_values * 2 ** dec_bits)
             var_name = var_name.replace('/', '_')
             var_name = var_name.replace(':', '_')
-            with open(name, 'a') as f:
-                f.write('#define ' + var_name.upper() + ' {')
             # CHW format
             if ('chw' in format):
                 if "dense" in var_name and "kernel" in var_name:
@@ -295,13 +406,39 @@ def generate_weights(model, name='weights.h', format='hwc', shift_list=None):
 
             print("  reshape to:",transposed_wts.shape)
 
+            # pruned kernels, the dense one is not written when the sparse one is used
+            sparse_wts = None
+            if ("kernel" in var_name and sparse and ch_dec_bits is None and is_sparse_layer(layer, format)):
+                sparse_wts = convert_to_sparse_weights(np.transpose(var_values) if "dense" in var_name else transposed_wts)
+                print("  non-zero blocks:", sparse_wts[3])
+                if (sparse_wts[3] > sparse):
+                    sparse_wts = None
+                else:
+                    sparse_layers.append(layer.name)
+
             with open(name, 'a') as f:
-                transposed_wts.tofile(f, sep=", ", format="%d")
-                f.write('}\n\n')
+                if (ch_dec_bits is not None):
+                    f.write('#define ' + var_name.upper() + '_INT4 {')
+                    convert_to_int4_weights(np.transpose(var_values) if "dense" in var_name else transposed_wts).tofile(f, sep=", ", format="%d")
+                    f.write('}\n\n')
+                elif (sparse_wts is None):
+                    f.write('#define ' + var_name.upper() + ' {')
+                    transposed_wts.tofile(f, sep=", ", format="%d")
+                    f.write('}\n\n')
+                else:
+                    for suffix, values in zip(['_SPARSE', '_SPARSE_IDX', '_SPARSE_PTR'], sparse_wts[:3]):
+                        f.write('#define ' + var_name.upper() + suffix + ' {')
+                        values.tofile(f, sep=", ", format="%d")
+                        f.write('}\n\n')
                 if ("bias" in var_name):
                     f.write('#define ' + var_name.upper() + '_SHIFT ' + '(' + str(dec_bits) + ')\n\n\n')
                 if ("kernel" in var_name ):
                     f.write('#define ' + var_name.upper() + '_SHIFT ' + '(' + str(dec_bits) + ')\n\n')
+                # the same kernel transformed for Winograd, q15. same shift
+                if ("kernel" in var_name and sparse_wts is None and ch_dec_bits is None and is_winograd_layer(layer, format, winograd)):
+                    f.write('#define ' + var_name.upper() + '_WINOGRAD {')
+                    convert_to_winograd_weights(transposed_wts).tofile(f, sep=", ", format="%d")
+                    f.write('}\n\n')
             """
             # for checking the quantised and dequantised range. 
             with K.tf.Session() as session:
@@ -313,6 +450,7 @@ def generate_weights(model, name='weights.h', format='hwc', shift_list=None):
                   ' max: (' + str(np.max(var_values)) + ',' + str(max_value) + ')' + \
                   ' min: (' + str(np.min(var_values)) + ',' + str(min_value) + ')')
             """
+    return sparse_layers, int4_layers
 
 def layers_output_ranges(model, x_test, kld=True, calibrate_size=1000):
     # limit the test data size
@@ -397,7 +535,7 @@ def layers_output_ranges(model, x_test, kld=True, calibrate_size=1000):
             shift_list[layer.name.split(':')[0]] = dec_bits
         else:
             shift_list[layer.name] = dec_bits
-        if ('batch_normalization' in layer.name):
+        if (is_fused_bn(layer)):
             shift_list[last_layer.name] = dec_bits  # use the bn layer shift to update the last layer.
         last_layer = layer
 
@@ -444,9 +582,11 @@ def layers_output_ranges(model, x_test, kld=True, calibrate_size=1000):
     print("shift list", shift_list)
     return shift_list
 
-def generate_model(model, x_test, name='weights.h', format='hwc', kld=True):
+def generate_model(model, x_test, name='weights.h', format='hwc', kld=True, winograd=True, sparse=0.5,
+                   int4=False, int4_per_channel=True):
     shift_list = layers_output_ranges(model, x_test, kld)
-    generate_weights(model, name=name, format=format, shift_list=shift_list)
+    sparse_layers, int4_layers = generate_weights(model, name=name, format=format, shift_list=shift_list,
+        winograd=winograd, sparse=sparse, int4=int4, int4_per_channel=int4_per_channel)
     if(type(model.layers[0]) != InputLayer):
         L = [model.input] + model.layers
     else:
@@ -463,11 +603,12 @@ def generate_model(model, x_test, name='weights.h', format='hwc', kld=True):
         for layer in model.layers:
             if(is_shift_layer(layer)):
                 iname = layer.name.upper()
-                if(len(layer.weights) == 2 and
-                   'kernel' in layer.weights[0].name and
-                   'bias' in layer.weights[1].name):
-                    kname = layer.weights[0].name.upper().replace('/', '_').replace(':', '_')
-                    bname = layer.weights[1].name.upper().replace('/', '_').replace(':', '_')
+                variables = [var_name for var_name, _ in layer_kernel_bias(layer)]
+                if(len(variables) == 2 and
+                   'kernel' in variables[0] and
+                   'bias' in variables[1]):
+                    kname = variables[0].upper().replace('/', '_').replace(':', '_')
+                    bname = variables[1].upper().replace('/', '_').replace(':', '_')
                     inp = layer.input.name.replace(':','/').split('/')[0].upper()
                     fp.write('#define {0}_OUTPUT_RSHIFT ({1}_OUTPUT_SHIFT+{2}_SHIFT-{0}_OUTPUT_SHIFT)\n'.format(
                             iname, inp, kname))
@@ -498,7 +639,7 @@ def generate_model(model, x_test, name='weights.h', format='hwc', kld=True):
             # FIXME: add more that could be skiped
             if('lambda' in layer.name or
                'dropout' in layer.name or
-               'batch_normalization' in layer.name or
+               is_fused_bn(layer) or
                 ('flatten' in layer.name and 'chw' not in format)): # flatten layer can be skipped in HWC but have to present in CHW
                 return True
             return False
@@ -513,13 +654,35 @@ def generate_model(model, x_test, name='weights.h', format='hwc', kld=True):
                     LI[layer.name] = (ID, layer)
                 ID += 1
 
-            if ('input' in layer.name or not layer.weights):
+            if ('input' in layer.name or not layer.weights or is_fused_bn(layer)):
                 continue
-            for var in layer.weights:
-                var_name = str(var.name).replace('/', '_').replace(':', '_')
-                if("kernel" in var_name):
+            for var_name, _ in layer_kernel_bias(layer):
+                var_name = var_name.replace('/', '_').replace(':', '_')
+                if("kernel" in var_name and layer.name in int4_layers):
+                    ch_shift = int4_layers[layer.name]
+                    fp.write('static const int8_t %s_int4[] = %s_INT4;\n'%(layer.name, var_name.upper()))
+                    if(ch_shift is not None):
+                        fp.write('static const uint8_t %s_int4_bshift[] = {%s};\n'%(layer.name,
+                            ', '.join(['%s_BIAS_LSHIFT+%d'%(layer.name.upper(), d) for d in ch_shift])))
+                        fp.write('static const uint8_t %s_int4_oshift[] = {%s};\n'%(layer.name,
+                            ', '.join(['%s_OUTPUT_RSHIFT+%d'%(layer.name.upper(), d) for d in ch_shift])))
+                        fp.write('static const nnom_int4_weight_t %s_w4 = { (const void*)%s_int4, %s_int4_bshift, %s_int4_oshift};\n'%(
+                            layer.name, layer.name, layer.name, layer.name))
+                    else:
+                        fp.write('static const nnom_int4_weight_t %s_w4 = { (const void*)%s_int4, NULL, NULL};\n'%(layer.name, layer.name))
+                    fp.write('static const nnom_weight_t %s_w = { NULL, %s_OUTPUT_RSHIFT};\n'%(layer.name, layer.name.upper()))
+                elif("kernel" in var_name and layer.name in sparse_layers):
+                    fp.write('static const int8_t %s_sparse[] = %s_SPARSE;\n'%(layer.name, var_name.upper()))
+                    fp.write('static const uint16_t %s_sparse_idx[] = %s_SPARSE_IDX;\n'%(layer.name, var_name.upper()))
+                    fp.write('static const uint32_t %s_sparse_ptr[] = %s_SPARSE_PTR;\n'%(layer.name, var_name.upper()))
+                    fp.write('static const nnom_sparse_weight_t %s_ws = { (const void*)%s_sparse, %s_sparse_idx, %s_sparse_ptr};\n'%(layer.name,layer.name,layer.name,layer.name))
+                    fp.write('static const nnom_weight_t %s_w = { NULL, %s_OUTPUT_RSHIFT};\n'%(layer.name, layer.name.upper()))
+                elif("kernel" in var_name):
                     fp.write('static const int8_t %s_weights[] = %s;\n'%(layer.name, var_name.upper()))
                     fp.write('static const nnom_weight_t %s_w = { (const void*)%s_weights, %s_OUTPUT_RSHIFT};\n'%(layer.name,layer.name, layer.name.upper()))
+                    if(is_winograd_layer(layer, format, winograd)):
+                        fp.write('static const int16_t %s_winograd[] = %s_WINOGRAD;\n'%(layer.name, var_name.upper()))
+                        fp.write('static const nnom_weight_t %s_ww = { (const void*)%s_winograd, %s_OUTPUT_RSHIFT};\n'%(layer.name,layer.name, layer.name.upper()))
                 elif("bias" in var_name):
                     fp.write('static const int8_t %s_bias[] = %s;\n'%(layer.name, var_name.upper()))
                     fp.write('static const nnom_bias_t %s_b = { (const void*)%s_bias, %s_BIAS_LSHIFT};\n'%(layer.name,layer.name, layer.name.upper()))
@@ -574,6 +737,9 @@ def generate_model(model, x_test, name='weights.h', format='hwc', kld=True):
                     fp.write('\tlayer[{0}] = model.hook(Conv2D({1}, kernel(1,{2}), stride(1,{3}), PADDING_{4}, &{5}_w, &{5}_b), layer[{6}]);\n'.format(
                         id, cfg['filters'], cfg['kernel_size'][0], cfg['strides'][0], cfg['padding'].upper(),
                         layer.name, LI[inp][0]))
+                # dilated kernel, the weights stay the same
+                if(cfg.get('dilation_rate', (1,))[0] != 1):
+                    fp.write('\tconv2d_dilation(layer[%d], dilation(1,%d));\n' % (id, cfg['dilation_rate'][0]))
             elif('conv2d' in layer.name):
                 inp = layer.input.name.replace(':','/').split('/')[0]
                 cfg = layer.get_config()
@@ -581,10 +747,24 @@ def generate_model(model, x_test, name='weights.h', format='hwc', kld=True):
                     fp.write('\tlayer[{0}] = model.hook(DW_Conv2D({1}, kernel{2}, stride{3}, PADDING_{4}, &{5}_w, &{5}_b), layer[{6}]);\n'.format(
                         id, 1, cfg['kernel_size'], cfg['strides'], cfg['padding'].upper(),
                         layer.name, LI[inp][0]))
+                elif(layer.name in int4_layers):
+                    fp.write('\tlayer[{0}] = model.hook(conv2d_int4(Conv2D({1}, kernel{2}, stride{3}, PADDING_{4}, &{5}_w, &{5}_b), &{5}_w4), layer[{6}]);\n'.format(
+                        id, cfg['filters'], cfg['kernel_size'], cfg['strides'], cfg['padding'].upper(),
+                        layer.name, LI[inp][0]))
+                elif(layer.name in sparse_layers):
+                    fp.write('\tlayer[{0}] = model.hook(conv2d_sparse(Conv2D({1}, kernel{2}, stride{3}, PADDING_{4}, &{5}_w, &{5}_b), &{5}_ws), layer[{6}]);\n'.format(
+                        id, cfg['filters'], cfg['kernel_size'], cfg['strides'], cfg['padding'].upper(),
+                        layer.name, LI[inp][0]))
+                elif(is_winograd_layer(layer, format, winograd)):
+                    fp.write('\tlayer[{0}] = model.hook(conv2d_winograd(Conv2D({1}, kernel{2}, stride{3}, PADDING_{4}, &{5}_w, &{5}_b), &{5}_ww), layer[{6}]);\n'.format(
+                        id, cfg['filters'], cfg['kernel_size'], cfg['strides'], cfg['padding'].upper(),
+                        layer.name, LI[inp][0]))
                 else:
                     fp.write('\tlayer[{0}] = model.hook(Conv2D({1}, kernel{2}, stride{3}, PADDING_{4}, &{5}_w, &{5}_b), layer[{6}]);\n'.format(
                         id, cfg['filters'], cfg['kernel_size'], cfg['strides'], cfg['padding'].upper(),
                         layer.name, LI[inp][0]))
+                if(tuple(cfg.get('dilation_rate', (1, 1))) != (1, 1)):
+                    fp.write('\tconv2d_dilation(layer[%d], dilation%s);\n' % (id, tuple(cfg['dilation_rate'])))
             # activations
             elif('activation' in layer.name):
                 inp = layer.input.name.replace(':','/').split('/')[0]
@@ -694,11 +874,23 @@ def generate_model(model, x_test, name='weights.h', format='hwc', kld=True):
             elif('dense' in layer.name):
                 inp = layer.input.name.replace(':','/').split('/')[0]
                 cfg = layer.get_config()
-                fp.write('\tlayer[{0}] = model.hook(Dense({1}, &{2}_w, &{2}_b), layer[{3}]);\n'.format(
-                    id, cfg['units'], layer.name, LI[inp][0]))
+                if(layer.name in int4_layers):
+                    fp.write('\tlayer[{0}] = model.hook(dense_int4(Dense({1}, &{2}_w, &{2}_b), &{2}_w4), layer[{3}]);\n'.format(
+                        id, cfg['units'], layer.name, LI[inp][0]))
+                elif(layer.name in sparse_layers):
+                    fp.write('\tlayer[{0}] = model.hook(dense_sparse(Dense({1}, &{2}_w, &{2}_b), &{2}_ws), layer[{3}]);\n'.format(
+                        id, cfg['units'], layer.name, LI[inp][0]))
+                else:
+                    fp.write('\tlayer[{0}] = model.hook(Dense({1}, &{2}_w, &{2}_b), layer[{3}]);\n'.format(
+                        id, cfg['units'], layer.name, LI[inp][0]))
             elif('softmax' in layer.name):
                 inp = layer.input.name.replace(':','/').split('/')[0]
                 fp.write('\tlayer[%s] = model.hook(Softmax(), layer[%s]);\n'%(id, LI[inp][0]))
+            # not fused offline, after Dense it is folded by the compiler
+            elif('batch_normalization' in layer.name):
+                inp = layer.input.name.replace(':','/').split('/')[0]
+                fp.write('\tlayer[{0}] = model.hook(BatchNorm(&{1}_w, &{1}_b), layer[{2}]);\n'.format(
+                    id, layer.name, LI[inp][0]))
             else:
                 raise Exception('unsupported layer', layer.name, layer)
 			
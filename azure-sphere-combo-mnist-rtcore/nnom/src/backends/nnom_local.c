@@ -19,6 +19,12 @@
 #include "nnom.h"
 #include "nnom_local.h"
 
+#if defined(NNOM_USING_CMSIS_NN) && defined(ARM_MATH_DSP)
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
+#endif
+
 
 
 
@@ -158,7 +164,9 @@ void local_maxpool_q7_HWC(const q7_t *Im_in,           // input image
     }
 }
 
-void local_maxpool_q7_CHW(const q7_t *Im_in,           // input image
+// same as local_maxpool_q7_HWC() but only computes the outputs inside
+// [out_x_start, out_x_end) x [out_y_start, out_y_end), the rest of Im_out is left untouched
+void local_maxpool_q7_HWC_region(const q7_t *Im_in,           // input image
 	const uint16_t dim_im_in_x,  // input image dimension x or W
 	const uint16_t dim_im_in_y,  // input image dimension y or H
 	const uint16_t ch_im_in,     // number of input image channels
@@ -169,44 +177,138 @@ void local_maxpool_q7_CHW(const q7_t *Im_in,           // input image
 	const uint16_t stride_x,     // stride
 	const uint16_t stride_y,     // stride
 	const uint16_t dim_im_out_x, // output image dimension x or W
-	const uint16_t dim_im_out_y, // output image dimension y or H
-	q7_t *bufferA,               // a buffer for local storage, NULL by now
+	const uint16_t out_x_start,  // first output column to compute
+	const uint16_t out_x_end,    // one past the last output column
+	const uint16_t out_y_start,  // first output row to compute
+	const uint16_t out_y_end,    // one past the last output row
 	q7_t *Im_out)
 {
     int16_t i_ch_in, i_x, i_y;
     int16_t k_x, k_y;
-	int32_t ch_offset;
 
-    for (i_ch_in = 0; i_ch_in < ch_im_in; i_ch_in++)
+    for (i_y = out_y_start; i_y < out_y_end; i_y++)
     {
-		ch_offset = i_ch_in * dim_im_out_x * dim_im_out_y; 
-        for (i_y = 0; i_y < dim_im_out_y; i_y++)
+        int16_t y_start = i_y * stride_y - padding_y;
+        int16_t y_end = y_start + dim_kernel_y;
+        if (y_start < 0)
+            y_start = 0;
+        if (y_end > dim_im_in_y)
+            y_end = dim_im_in_y;
+
+        for (i_x = out_x_start; i_x < out_x_end; i_x++)
         {
-            for (i_x = 0; i_x < dim_im_out_x; i_x++)
+            int16_t x_start = i_x * stride_x - padding_x;
+            int16_t x_end = x_start + dim_kernel_x;
+            if (x_start < 0)
+                x_start = 0;
+            if (x_end > dim_im_in_x)
+                x_end = dim_im_in_x;
+
+            q7_t *out = Im_out + ch_im_in * (i_x + i_y * dim_im_out_x);
+            for (i_ch_in = 0; i_ch_in < ch_im_in; i_ch_in++)
             {
                 int max = -129;
-                for (k_y = i_y * stride_y - padding_y; k_y < i_y * stride_y - padding_y + dim_kernel_y; k_y++)
+                for (k_y = y_start; k_y < y_end; k_y++)
                 {
-                    for (k_x = i_x * stride_x - padding_x; k_x < i_x * stride_x - padding_x + dim_kernel_x; k_x++)
+                    for (k_x = x_start; k_x < x_end; k_x++)
                     {
-                        if (k_y >= 0 && k_x >= 0 && k_y < dim_im_in_y && k_x < dim_im_in_x)
-                        {
-                            if (Im_in[i_ch_in * dim_im_in_x * dim_im_in_y + (k_x + k_y * dim_im_in_x)] > max)
-                            {
-                                max = Im_in[i_ch_in * dim_im_in_x * dim_im_in_y + (k_x + k_y * dim_im_in_x)];
-                            }
-                        }
+                        if (Im_in[i_ch_in + ch_im_in * (k_x + k_y * dim_im_in_x)] > max)
+                            max = Im_in[i_ch_in + ch_im_in * (k_x + k_y * dim_im_in_x)];
                     }
                 }
-                Im_out[ch_offset+(i_x + i_y * dim_im_out_x)] = max;
+                out[i_ch_in] = max;
             }
         }
     }
 }
 
-// temporary for the thesis
-// shift according to the maximum
-int32_t local_sumpool_q7_HWC(const q7_t *Im_in,           // input image
+// the channel-wise max of dst and src into dst
+static void max_q7(q7_t *dst, const q7_t *src, uint32_t size)
+{
+	uint32_t i = 0;
+
+#if defined(NNOM_USING_CMSIS_NN) && defined(ARM_MATH_DSP)
+	for (; i + 4 <= size; i += 4)
+	{
+		q31_t a = arm_nn_read_q7x4(dst + i);
+		q31_t b = arm_nn_read_q7x4(src + i);
+
+		__SSUB8(a, b);
+		a = __SEL(a, b);
+		memcpy(dst + i, &a, 4);
+	}
+#endif
+	for (; i < size; i++)
+		if (src[i] > dst[i])
+			dst[i] = src[i];
+}
+
+// 1D pooling, dim_im_in pixels in a row. The channels of each pixel are contiguous, so the window
+// is reduced one whole pixel at a time instead of one channel at a time.
+void local_maxpool_1D_HWC_q7(const q7_t *Im_in, // input signal
+	const uint16_t dim_im_in,    // input length
+	const uint16_t ch_im_in,     // number of input channels
+	const uint16_t dim_kernel,   // window kernel size
+	const uint16_t padding,      // padding sizes
+	const uint16_t stride,       // stride
+	const uint16_t dim_im_out,   // output length
+	q7_t *Im_out)
+{
+	int32_t i, k, start, end;
+
+	for (i = 0; i < dim_im_out; i++)
+	{
+		start = i * stride - padding;
+		end = start + dim_kernel;
+		start = start > 0 ? start : 0;
+		end = end < dim_im_in ? end : dim_im_in;
+
+		memcpy(Im_out, Im_in + start * ch_im_in, ch_im_in);
+		for (k = start + 1; k < end; k++)
+			max_q7(Im_out, Im_in + k * ch_im_in, ch_im_in);
+		Im_out += ch_im_in;
+	}
+}
+
+// same rounding as local_avepool_q7_HWC()
+void local_avepool_1D_HWC_q7(const q7_t *Im_in, // input signal
+	const uint16_t dim_im_in,    // input length
+	const uint16_t ch_im_in,     // number of input channels
+	const uint16_t dim_kernel,   // window kernel size
+	const uint16_t padding,      // padding sizes
+	const uint16_t stride,       // stride
+	const uint16_t dim_im_out,   // output length
+	const uint16_t output_shift, // output right shift
+	q31_t *bufferA,              // size = 4*ch_im_in bytes
+	q7_t *Im_out)
+{
+	int32_t i, k, c, start, end, count;
+	const q7_t *in;
+
+	for (i = 0; i < dim_im_out; i++)
+	{
+		start = i * stride - padding;
+		end = start + dim_kernel;
+		start = start > 0 ? start : 0;
+		end = end < dim_im_in ? end : dim_im_in;
+		count = (end - start) >> output_shift;
+
+		in = Im_in + start * ch_im_in;
+		for (c = 0; c < ch_im_in; c++)
+			bufferA[c] = in[c];
+		for (k = start + 1; k < end; k++)
+		{
+			in += ch_im_in;
+			for (c = 0; c < ch_im_in; c++)
+				bufferA[c] += in[c];
+		}
+		for (c = 0; c < ch_im_in; c++)
+			Im_out[c] = bufferA[c] / count;
+		Im_out += ch_im_in;
+	}
+}
+
+void local_maxpool_q7_CHW(const q7_t *Im_in,           // input image
 	const uint16_t dim_im_in_x,  // input image dimension x or W
 	const uint16_t dim_im_in_y,  // input image dimension y or H
 	const uint16_t ch_im_in,     // number of input image channels
@@ -218,62 +320,153 @@ int32_t local_sumpool_q7_HWC(const q7_t *Im_in,           // input image
 	const uint16_t stride_y,     // stride
 	const uint16_t dim_im_out_x, // output image dimension x or W
 	const uint16_t dim_im_out_y, // output image dimension y or H
-	q7_t *bufferA,               // a buffer for local storage, size = 4*output_size
+	q7_t *bufferA,               // a buffer for local storage, NULL by now
 	q7_t *Im_out)
 {
     int16_t i_ch_in, i_x, i_y;
     int16_t k_x, k_y;
-    int32_t *buf = (int32_t *)bufferA;
-	// stage2
-    int32_t max_abs = 0;
-    int32_t output_shift;
-    size_t output_size = dim_im_out_x * dim_im_out_x * ch_im_in;
+	int32_t ch_offset;
 
-    // save in 32bit
     for (i_ch_in = 0; i_ch_in < ch_im_in; i_ch_in++)
     {
+		ch_offset = i_ch_in * dim_im_out_x * dim_im_out_y; 
         for (i_y = 0; i_y < dim_im_out_y; i_y++)
         {
             for (i_x = 0; i_x < dim_im_out_x; i_x++)
             {
-                int sum = 0;
+                int max = -129;
                 for (k_y = i_y * stride_y - padding_y; k_y < i_y * stride_y - padding_y + dim_kernel_y; k_y++)
                 {
                     for (k_x = i_x * stride_x - padding_x; k_x < i_x * stride_x - padding_x + dim_kernel_x; k_x++)
                     {
                         if (k_y >= 0 && k_x >= 0 && k_y < dim_im_in_y && k_x < dim_im_in_x)
                         {
-                            sum += Im_in[i_ch_in + ch_im_in * (k_x + k_y * dim_im_in_x)];
+                            if (Im_in[i_ch_in * dim_im_in_x * dim_im_in_y + (k_x + k_y * dim_im_in_x)] > max)
+                            {
+                                max = Im_in[i_ch_in * dim_im_in_x * dim_im_in_y + (k_x + k_y * dim_im_in_x)];
+                            }
                         }
                     }
                 }
-                // 32bit
-                buf[i_ch_in + ch_im_in * (i_x + i_y * dim_im_out_x)] = sum;
+                Im_out[ch_offset+(i_x + i_y * dim_im_out_x)] = max;
             }
         }
     }
+}
+
+// The sum pooling output shift is the smallest one which fits the largest sum into q7.
+static int32_t local_sumpool_shift(int32_t max_abs)
+{
+    int32_t output_shift;
 
-    // find max amount results
-    for (int i = 0; i < output_size; i++)
-    {
-        int32_t val = buf[i];
-        if (val < 0)
-            val = -val;
-        if (val > max_abs)
-            max_abs = val;
-    }
-    // find best shift to cover the max
     for (output_shift = 0;; output_shift++)
     {
         if (127 * (1 + output_shift) >= max_abs)
             break;
     }
+    return output_shift;
+}
 
-    // shift the results
-    for (int i = 0; i < output_size; i++)
+// One pass of sum pooling over either layout. The element (c, y, x) is read at
+// c * ch_step + (x + y * dim_im_in_x) * px_step, written alike with out_ch_step/out_px_step.
+// With Im_out == NULL it only returns the largest absolute sum, otherwise it writes the sums
+// shifted by output_shift. Summing twice is cheaper than storing every sum in q31 and reading
+// it back, and no scratch buffer is needed.
+static int32_t local_sumpool_pass_q7(const q7_t *Im_in,
+	const uint16_t dim_im_in_x,
+	const uint16_t dim_im_in_y,
+	const uint16_t ch_im_in,
+	const uint16_t dim_kernel_x,
+	const uint16_t dim_kernel_y,
+	const uint16_t padding_x,
+	const uint16_t padding_y,
+	const uint16_t stride_x,
+	const uint16_t stride_y,
+	const uint16_t dim_im_out_x,
+	const uint16_t dim_im_out_y,
+	const uint32_t ch_step,
+	const uint32_t px_step,
+	const uint32_t out_ch_step,
+	const uint32_t out_px_step,
+	const int32_t output_shift,
+	q7_t *Im_out)
+{
+    int32_t i_ch_in, i_x, i_y;
+    int32_t k_x, k_y, x0, x1, y0, y1;
+    int32_t max_abs = 0;
+    const q7_t *pch;
+
+    for (i_ch_in = 0; i_ch_in < ch_im_in; i_ch_in++)
     {
-        Im_out[i] = buf[i] >> output_shift;
+        pch = Im_in + i_ch_in * ch_step;
+        for (i_y = 0; i_y < dim_im_out_y; i_y++)
+        {
+            // clip the window to the image once, instead of checking every pixel
+            y0 = i_y * stride_y - padding_y;
+            y1 = y0 + dim_kernel_y;
+            y0 = y0 < 0 ? 0 : y0;
+            y1 = y1 > dim_im_in_y ? dim_im_in_y : y1;
+
+            for (i_x = 0; i_x < dim_im_out_x; i_x++)
+            {
+                int32_t sum = 0;
+
+                x0 = i_x * stride_x - padding_x;
+                x1 = x0 + dim_kernel_x;
+                x0 = x0 < 0 ? 0 : x0;
+                x1 = x1 > dim_im_in_x ? dim_im_in_x : x1;
+
+                for (k_y = y0; k_y < y1; k_y++)
+                {
+                    for (k_x = x0; k_x < x1; k_x++)
+                        sum += pch[(k_x + k_y * dim_im_in_x) * px_step];
+                }
+
+                if (Im_out != NULL)
+                {
+                    Im_out[i_ch_in * out_ch_step + (i_x + i_y * dim_im_out_x) * out_px_step] = sum >> output_shift;
+                }
+                else
+                {
+                    if (sum < 0)
+                        sum = -sum;
+                    if (sum > max_abs)
+                        max_abs = sum;
+                }
+            }
+        }
     }
+    return max_abs;
+}
+
+// temporary for the thesis
+// shift according to the maximum
+int32_t local_sumpool_q7_HWC(const q7_t *Im_in,           // input image
+	const uint16_t dim_im_in_x,  // input image dimension x or W
+	const uint16_t dim_im_in_y,  // input image dimension y or H
+	const uint16_t ch_im_in,     // number of input image channels
+	const uint16_t dim_kernel_x, // window kernel size
+	const uint16_t dim_kernel_y, // window kernel size
+	const uint16_t padding_x,    // padding sizes
+	const uint16_t padding_y,    // padding sizes
+	const uint16_t stride_x,     // stride
+	const uint16_t stride_y,     // stride
+	const uint16_t dim_im_out_x, // output image dimension x or W
+	const uint16_t dim_im_out_y, // output image dimension y or H
+	q7_t *bufferA,               // NULL by now
+	q7_t *Im_out)
+{
+    int32_t max_abs;
+    int32_t output_shift;
+
+    // first pass finds the range, the second writes the shifted sums
+    max_abs = local_sumpool_pass_q7(Im_in, dim_im_in_x, dim_im_in_y, ch_im_in,
+                dim_kernel_x, dim_kernel_y, padding_x, padding_y, stride_x, stride_y,
+                dim_im_out_x, dim_im_out_y, 1, ch_im_in, 1, ch_im_in, 0, NULL);
+    output_shift = local_sumpool_shift(max_abs);
+    local_sumpool_pass_q7(Im_in, dim_im_in_x, dim_im_in_y, ch_im_in,
+                dim_kernel_x, dim_kernel_y, padding_x, padding_y, stride_x, stride_y,
+                dim_im_out_x, dim_im_out_y, 1, ch_im_in, 1, ch_im_in, output_shift, Im_out);
     return output_shift;
 }
 
@@ -291,138 +484,1005 @@ int32_t local_sumpool_q7_CHW(const q7_t *Im_in,           // input image
 	const uint16_t stride_y,     // stride
 	const uint16_t dim_im_out_x, // output image dimension x or W
 	const uint16_t dim_im_out_y, // output image dimension y or H
-	q7_t *bufferA,               // a buffer for local storage, size = 4*output_size
+	q7_t *bufferA,               // NULL by now
 	q7_t *Im_out)
 {
-    int16_t i_ch_in, i_x, i_y;
-    int16_t k_x, k_y;
-    int32_t *buf = (int32_t *)bufferA;
-	int32_t i_ch_offset, o_ch_offset;
-	// stage2
-    int32_t max_abs = 0;
+    int32_t max_abs;
     int32_t output_shift;
-    size_t output_size = dim_im_out_x * dim_im_out_x * ch_im_in;
 
-    // save in 32bit
-    for (i_ch_in = 0; i_ch_in < ch_im_in; i_ch_in++)
-    {
-		i_ch_offset = i_ch_in*dim_im_in_x*dim_im_in_y;
-		o_ch_offset = i_ch_in*dim_im_out_x*dim_im_out_y;
-		
-        for (i_y = 0; i_y < dim_im_out_y; i_y++)
-        {
-            for (i_x = 0; i_x < dim_im_out_x; i_x++)
-            {
-                int sum = 0;
-                for (k_y = i_y * stride_y - padding_y; k_y < i_y * stride_y - padding_y + dim_kernel_y; k_y++)
-                {
-                    for (k_x = i_x * stride_x - padding_x; k_x < i_x * stride_x - padding_x + dim_kernel_x; k_x++)
-                    {
-                        if (k_y >= 0 && k_x >= 0 && k_y < dim_im_in_y && k_x < dim_im_in_x)
-                        {
-                            sum += Im_in[i_ch_offset + (k_x + k_y * dim_im_in_x)];
-                        }
-                    }
-                }
-                // 32bit
-                buf[o_ch_offset + (i_x + i_y * dim_im_out_x)] = sum;
-            }
-        }
-    }
+    max_abs = local_sumpool_pass_q7(Im_in, dim_im_in_x, dim_im_in_y, ch_im_in,
+                dim_kernel_x, dim_kernel_y, padding_x, padding_y, stride_x, stride_y,
+                dim_im_out_x, dim_im_out_y, dim_im_in_x * dim_im_in_y, 1, dim_im_out_x * dim_im_out_y, 1, 0, NULL);
+    output_shift = local_sumpool_shift(max_abs);
+    local_sumpool_pass_q7(Im_in, dim_im_in_x, dim_im_in_y, ch_im_in,
+                dim_kernel_x, dim_kernel_y, padding_x, padding_y, stride_x, stride_y,
+                dim_im_out_x, dim_im_out_y, dim_im_in_x * dim_im_in_y, 1, dim_im_out_x * dim_im_out_y, 1, output_shift, Im_out);
+    return output_shift;
+}
+
+// Global pooling reduces the whole map to one value per channel, so there is no window,
+// stride or padding to check. The HWC map is read once in memory order; with the DSP
+// extension 4 channels are added per word: SXTB16 splits them into 2 pairs of q15 and
+// SADD16 accumulates each pair. The q15 partial sums are folded into q31 every 256 pixels,
+// before they can overflow. Without DSP the same loops are left to the compiler to vectorise.
+#define GLOBAL_POOL_BLOCK	(256)
+
+// sum[ch] gets the total of each channel, part is ch q15 of scratch. both 4 bytes aligned
+static void local_global_sum_q7_HWC(const q7_t *Im_in, uint32_t size, uint16_t ch, q31_t *sum, q15_t *part)
+{
+	uint32_t i, n, c;
+
+	memset(sum, 0, ch * sizeof(q31_t));
+	while (size > 0)
+	{
+		n = size < GLOBAL_POOL_BLOCK ? size : GLOBAL_POOL_BLOCK;
+		size -= n;
+		memset(part, 0, ch * sizeof(q15_t));
+
+		for (i = 0; i < n; i++, Im_in += ch)
+		{
+			c = 0;
+#if defined(NNOM_USING_CMSIS_NN) && defined(ARM_MATH_DSP)
+			// part holds channel 0,2,1,3 of every group of 4
+			for (; c + 4 <= ch; c += 4)
+			{
+				q31_t in = arm_nn_read_q7x4(Im_in + c);
+				q31_t *p = (q31_t *)(part + c);
+
+				p[0] = __SADD16(p[0], __SXTB16(in));
+				p[1] = __SADD16(p[1], __SXTB16(__ROR(in, 8)));
+			}
+#endif
+			for (; c < ch; c++)
+				part[c] += Im_in[c];
+		}
+
+		c = 0;
+#if defined(NNOM_USING_CMSIS_NN) && defined(ARM_MATH_DSP)
+		for (; c + 4 <= ch; c += 4)
+		{
+			sum[c] += part[c];
+			sum[c + 1] += part[c + 2];
+			sum[c + 2] += part[c + 1];
+			sum[c + 3] += part[c + 3];
+		}
+#endif
+		for (; c < ch; c++)
+			sum[c] += part[c];
+	}
+}
+
+void local_global_maxpool_q7_HWC(const q7_t *Im_in, // input image
+	const uint16_t dim_im_in_x,  // input image dimension x or W
+	const uint16_t dim_im_in_y,  // input image dimension y or H
+	const uint16_t ch_im_in,     // number of input image channels
+	q7_t *Im_out)
+{
+	uint32_t size = dim_im_in_x * dim_im_in_y;
+	uint32_t i, c;
+
+	// the output may be the first pixel of the input, which is consumed first
+	memmove(Im_out, Im_in, ch_im_in);
+	for (i = 1; i < size; i++)
+	{
+		Im_in += ch_im_in;
+		c = 0;
+#if defined(NNOM_USING_CMSIS_NN) && defined(ARM_MATH_DSP)
+		for (; c + 4 <= ch_im_in; c += 4)
+		{
+			q31_t max = arm_nn_read_q7x4(Im_out + c);
+			q31_t in = arm_nn_read_q7x4(Im_in + c);
+
+			// GE flags are set for the bytes where max >= in
+			(void)__SSUB8(max, in);
+			max = __SEL(max, in);
+			memcpy(Im_out + c, &max, 4);
+		}
+#endif
+		for (; c < ch_im_in; c++)
+		{
+			if (Im_in[c] > Im_out[c])
+				Im_out[c] = Im_in[c];
+		}
+	}
+}
+
+void local_global_maxpool_q7_CHW(const q7_t *Im_in, // input image
+	const uint16_t dim_im_in_x,  // input image dimension x or W
+	const uint16_t dim_im_in_y,  // input image dimension y or H
+	const uint16_t ch_im_in,     // number of input image channels
+	q7_t *Im_out)
+{
+	uint32_t size = dim_im_in_x * dim_im_in_y;
+	uint32_t i, c;
+	q7_t max;
+
+	for (c = 0; c < ch_im_in; c++, Im_in += size)
+	{
+		max = Im_in[0];
+		for (i = 1; i < size; i++)
+		{
+			if (Im_in[i] > max)
+				max = Im_in[i];
+		}
+		Im_out[c] = max;
+	}
+}
+
+void local_global_avepool_q7_HWC(const q7_t *Im_in, // input image
+	const uint16_t dim_im_in_x,  // input image dimension x or W
+	const uint16_t dim_im_in_y,  // input image dimension y or H
+	const uint16_t ch_im_in,     // number of input image channels
+	const uint16_t output_shift, // output right shift
+	q7_t *bufferA,               // a buffer for local storage, size = 6*ch_im_in
+	q7_t *Im_out)
+{
+	uint32_t size = dim_im_in_x * dim_im_in_y;
+	q31_t *sum = (q31_t *)bufferA;
+
+	local_global_sum_q7_HWC(Im_in, size, ch_im_in, sum, (q15_t *)(sum + ch_im_in));
+
+	// rounds the same way as local_avepool_q7_HWC()
+	for (uint32_t c = 0; c < ch_im_in; c++)
+		Im_out[c] = sum[c] / (int32_t)(size >> output_shift);
+}
+
+void local_global_avepool_q7_CHW(const q7_t *Im_in, // input image
+	const uint16_t dim_im_in_x,  // input image dimension x or W
+	const uint16_t dim_im_in_y,  // input image dimension y or H
+	const uint16_t ch_im_in,     // number of input image channels
+	const uint16_t output_shift, // output right shift
+	q7_t *bufferA,               // NULL
+	q7_t *Im_out)
+{
+	uint32_t size = dim_im_in_x * dim_im_in_y;
+	uint32_t i, c;
+	int32_t sum;
+
+	for (c = 0; c < ch_im_in; c++, Im_in += size)
+	{
+		sum = 0;
+		for (i = 0; i < size; i++)
+			sum += Im_in[i];
+		Im_out[c] = sum / (int32_t)(size >> output_shift);
+	}
+}
+
+// same output and shift as local_sumpool_q7_HWC() with the kernel covering the whole map
+int32_t local_global_sumpool_q7_HWC(const q7_t *Im_in, // input image
+	const uint16_t dim_im_in_x,  // input image dimension x or W
+	const uint16_t dim_im_in_y,  // input image dimension y or H
+	const uint16_t ch_im_in,     // number of input image channels
+	q7_t *bufferA,               // a buffer for local storage, size = 6*ch_im_in
+	q7_t *Im_out)
+{
+	q31_t *sum = (q31_t *)bufferA;
+	int32_t max_abs = 0;
+	int32_t output_shift;
+
+	local_global_sum_q7_HWC(Im_in, dim_im_in_x * dim_im_in_y, ch_im_in, sum, (q15_t *)(sum + ch_im_in));
+
+	for (uint32_t c = 0; c < ch_im_in; c++)
+	{
+		int32_t val = sum[c] < 0 ? -sum[c] : sum[c];
+		if (val > max_abs)
+			max_abs = val;
+	}
+	output_shift = local_sumpool_shift(max_abs);
+
+	for (uint32_t c = 0; c < ch_im_in; c++)
+		Im_out[c] = sum[c] >> output_shift;
+	return output_shift;
+}
+
+int32_t local_global_sumpool_q7_CHW(const q7_t *Im_in, // input image
+	const uint16_t dim_im_in_x,  // input image dimension x or W
+	const uint16_t dim_im_in_y,  // input image dimension y or H
+	const uint16_t ch_im_in,     // number of input image channels
+	q7_t *bufferA,               // a buffer for local storage, size = 4*ch_im_in
+	q7_t *Im_out)
+{
+	uint32_t size = dim_im_in_x * dim_im_in_y;
+	q31_t *sum = (q31_t *)bufferA;
+	int32_t max_abs = 0;
+	int32_t output_shift;
+	uint32_t i, c;
+
+	for (c = 0; c < ch_im_in; c++)
+	{
+		int32_t val = 0;
+		for (i = 0; i < size; i++)
+			val += Im_in[c * size + i];
+		sum[c] = val;
+
+		if (val < 0)
+			val = -val;
+		if (val > max_abs)
+			max_abs = val;
+	}
+	output_shift = local_sumpool_shift(max_abs);
+
+	for (c = 0; c < ch_im_in; c++)
+		Im_out[c] = sum[c] >> output_shift;
+	return output_shift;
+}
+
+// customised up sample pooling
+void local_up_sampling_q7_HWC(const q7_t *Im_in,       // input image
+	const uint16_t dim_im_in_x,  // input image dimension x or W
+	const uint16_t dim_im_in_y,  // input image dimension y or H
+	const uint16_t ch_im_in,     // number of input image channels
+	const uint16_t dim_kernel_x, // window kernel size
+	const uint16_t dim_kernel_y, // window kernel size
+	const uint16_t dim_im_out_x, // output image dimension x or W
+	const uint16_t dim_im_out_y, // output image dimension y or H
+	q7_t *bufferA,               // a buffer for local storage, NULL by now
+	q7_t *Im_out)
+{
+    int16_t i_x, i_y, i;
+    const uint32_t row = dim_im_in_x * dim_kernel_x * ch_im_in;
+
+    for (i_y = 0; i_y < dim_im_in_y; i_y++)
+    {
+        const q7_t *p_in = Im_in + i_y * dim_im_in_x * ch_im_in;
+        q7_t *p_row = Im_out + i_y * dim_kernel_y * row;
+        q7_t *pout = p_row;
+
+        // the first output row, each pixel copied dim_kernel_x times with all its channels
+        for (i_x = 0; i_x < dim_im_in_x; i_x++)
+        {
+            for (i = 0; i < dim_kernel_x; i++)
+            {
+                memcpy(pout, p_in, ch_im_in);
+                pout += ch_im_in;
+            }
+            p_in += ch_im_in;
+        }
+        // then the whole row duplicated into the y axis
+        for (i = 1; i < dim_kernel_y; i++)
+            memcpy(p_row + i * row, p_row, row);
+    }
+}
+
+void local_up_sampling_q7_CHW(const q7_t *Im_in,       // input image
+	const uint16_t dim_im_in_x,  // input image dimension x or W
+	const uint16_t dim_im_in_y,  // input image dimension y or H
+	const uint16_t ch_im_in,     // number of input image channels
+	const uint16_t dim_kernel_x, // window kernel size
+	const uint16_t dim_kernel_y, // window kernel size
+	const uint16_t dim_im_out_x, // output image dimension x or W
+	const uint16_t dim_im_out_y, // output image dimension y or H
+	q7_t *bufferA,               // a buffer for local storage, NULL by now
+	q7_t *Im_out)
+{
+	int16_t i_x, i_y, ch, i;
+	const uint32_t row = dim_im_in_x * dim_kernel_x;
+
+	for (ch = 0; ch < ch_im_in; ch++)
+	{
+		for (i_y = 0; i_y < dim_im_in_y; i_y++)
+		{
+			const q7_t *p_in = Im_in + (ch * dim_im_in_y + i_y) * dim_im_in_x;
+			q7_t *p_row = Im_out + ch * dim_im_out_x * dim_im_out_y + i_y * dim_kernel_y * row;
+
+			// the first output row, then the whole row duplicated into the y axis
+			for (i_x = 0; i_x < dim_im_in_x; i_x++)
+				memset(p_row + i_x * dim_kernel_x, p_in[i_x], dim_kernel_x);
+			for (i = 1; i < dim_kernel_y; i++)
+				memcpy(p_row + i * row, p_row, row);
+		}
+	}
+}
+
+
+void local_convolve_HWC_q7_nonsquare(const q7_t *Im_in,                // input image
+	const uint16_t dim_im_in_x,                                        // input image dimention x
+	const uint16_t dim_im_in_y,                                        // input image dimention y
+	const uint16_t ch_im_in,                                           // number of input image channels
+	const q7_t *wt,                                                    // kernel weights
+	const uint16_t ch_im_out,                                          // number of filters, i.e., output image channels
+	const uint16_t dim_kernel_x,                                       // filter kernel size x
+	const uint16_t dim_kernel_y,                                       // filter kernel size y
+	const uint16_t padding_x,                                          // padding sizes x
+	const uint16_t padding_y,                                          // padding sizes y
+	const uint16_t stride_x,                                           // stride x
+	const uint16_t stride_y,                                           // stride y
+	const q7_t *bias,                                                  // bias
+	const uint16_t bias_shift, const uint16_t out_shift, q7_t *Im_out, // output image
+	const uint16_t dim_im_out_x,                                       // output image dimension x
+	const uint16_t dim_im_out_y,                                       // output image dimension y
+	q15_t *bufferA,                                                    //buffer space for input
+	q7_t *bufferB                                                      //buffer space for output
+)
+{
+    int i, j, k, l, m, n;
+    int conv_out;
+    int in_row, in_col;
+
+    for (i = 0; i < ch_im_out; i++)
+    {
+        for (j = 0; j < dim_im_out_y; j++)
+        {
+            for (k = 0; k < dim_im_out_x; k++)
+            {
+#ifndef NNOM_TRUNCATE
+                conv_out = ((q31_t)(bias[i]) << bias_shift) + (0x1 << (out_shift - 1));
+#else
+                conv_out = bias[i] << bias_shift;
+#endif
+                for (m = 0; m < dim_kernel_y; m++)
+                {
+                    for (n = 0; n < dim_kernel_x; n++)
+                    {
+                        // if-for implementation
+                        in_row = stride_y * j + m - padding_y;
+                        in_col = stride_x * k + n - padding_x;
+                        if (in_row >= 0 && in_col >= 0 && in_row < dim_im_in_y && in_col < dim_im_in_x)
+                        {
+                            for (l = 0; l < ch_im_in; l++)
+                            {
+                                conv_out += Im_in[(in_row * dim_im_in_x + in_col) * ch_im_in + l] *
+                                            wt[i * ch_im_in * dim_kernel_y * dim_kernel_x + (m * dim_kernel_x + n) * ch_im_in +
+                                               l];
+                            }
+                        }
+                    }
+                }
+                Im_out[i + (j * dim_im_out_x + k) * ch_im_out] = (q7_t)__NNOM_SSAT((conv_out >> out_shift), 8);
+            }
+        }
+    }
+}
+
+
+// Winograd F(2x2, 3x3) convolution for 3x3 kernels with stride 1.
+// wt is the kernel transformed offline to U = G g G^T, with G = [2 0 0; 1 1 1; 1 -1 1; 0 0 2].
+// It is q15 in the layout [ch_im_out][16][ch_im_in]. G is twice the textbook matrix, so U, the
+// input transform B^T d B and the output transform A^T M A are all integer. Each output is then
+// exactly 4 times the direct sum, and >> 2 gives the same result as the direct convolution.
+// One 2x2 output tile takes 16 MACs per input channel instead of 36. The transformed inputs
+// stay within 4*128, U within 9*128, so the products accumulate in q31 as usual.
+// Two tiles and two filters are done together: with SMLAD that is 4 loads for 8 MACs.
+
+// B^T d B of the 4x4 patch at (x0, y0) for every channel, V is [16][ch_im_in]
+static void winograd_input_tile(const q7_t *Im_in,
+	const uint16_t dim_im_in_x, const uint16_t dim_im_in_y, const uint16_t ch_im_in,
+	int32_t x0, int32_t y0, const q7_t *zeros, q15_t *V)
+{
+	const q7_t *p[16];
+	int32_t x, y, i, c;
+	q15_t d[16], t[16];
+
+	// padding reads from a row of zeros
+	for (i = 0; i < 16; i++)
+	{
+		y = y0 + i / 4;
+		x = x0 + i % 4;
+		if (y >= 0 && x >= 0 && y < dim_im_in_y && x < dim_im_in_x)
+			p[i] = Im_in + (y * dim_im_in_x + x) * ch_im_in;
+		else
+			p[i] = zeros;
+	}
+
+	for (c = 0; c < ch_im_in; c++)
+	{
+		for (i = 0; i < 16; i++)
+			d[i] = p[i][c];
+
+		// B^T d, B^T = [1 0 -1 0; 0 1 1 0; 0 -1 1 0; 0 1 0 -1]
+		for (i = 0; i < 4; i++)
+		{
+			t[i] = d[i] - d[8 + i];
+			t[4 + i] = d[4 + i] + d[8 + i];
+			t[8 + i] = d[8 + i] - d[4 + i];
+			t[12 + i] = d[4 + i] - d[12 + i];
+		}
+		// (B^T d) B
+		for (i = 0; i < 16; i += 4)
+		{
+			V[(i + 0) * ch_im_in + c] = t[i] - t[i + 2];
+			V[(i + 1) * ch_im_in + c] = t[i + 1] + t[i + 2];
+			V[(i + 2) * ch_im_in + c] = t[i + 2] - t[i + 1];
+			V[(i + 3) * ch_im_in + c] = t[i + 1] - t[i + 3];
+		}
+	}
+}
+
+// A^T M A, A^T = [1 1 1 0; 0 1 -1 -1]. writes the part of the 2x2 tile inside the image
+static void winograd_output_tile(const q31_t *m, q31_t base, const uint16_t out_shift,
+	q7_t *Im_out, const uint16_t ch_im_out, const uint16_t dim_im_out_x, const uint16_t dim_im_out_y,
+	int32_t x0, int32_t y0)
+{
+	q31_t t[8], y[4];
+	int32_t i;
+
+	for (i = 0; i < 4; i++)
+	{
+		t[i] = m[i] + m[4 + i] + m[8 + i];
+		t[4 + i] = m[4 + i] - m[8 + i] - m[12 + i];
+	}
+	for (i = 0; i < 2; i++)
+	{
+		y[i * 2] = t[i * 4] + t[i * 4 + 1] + t[i * 4 + 2];
+		y[i * 2 + 1] = t[i * 4 + 1] - t[i * 4 + 2] - t[i * 4 + 3];
+	}
+
+	for (i = 0; i < 4; i++)
+	{
+		int32_t x = x0 + (i & 1);
+		int32_t yy = y0 + (i >> 1);
+
+		if (x < dim_im_out_x && yy < dim_im_out_y)
+			Im_out[(yy * dim_im_out_x + x) * ch_im_out] = (q7_t)__NNOM_SSAT(((y[i] >> 2) + base) >> out_shift, 8);
+	}
+}
+
+void local_convolve_HWC_q7_winograd(const q7_t *Im_in,                 // input image
+	const uint16_t dim_im_in_x,                                        // input image dimention x
+	const uint16_t dim_im_in_y,                                        // input image dimention y
+	const uint16_t ch_im_in,                                           // number of input image channels
+	const q15_t *wt,                                                   // transformed kernel weights
+	const uint16_t ch_im_out,                                          // number of filters, i.e., output image channels
+	const uint16_t padding_x,                                          // padding sizes x
+	const uint16_t padding_y,                                          // padding sizes y
+	const q7_t *bias,                                                  // bias
+	const uint16_t bias_shift, const uint16_t out_shift, q7_t *Im_out, // output image
+	const uint16_t dim_im_out_x,                                       // output image dimension x
+	const uint16_t dim_im_out_y,                                       // output image dimension y
+	q15_t *bufferA)                                                    // size = 65*ch_im_in bytes
+{
+	q15_t *V0 = bufferA;
+	q15_t *V1 = bufferA + 16 * ch_im_in;
+	q7_t *zeros = (q7_t *)(bufferA + 32 * ch_im_in);
+	int32_t tx, ty, k, xi, c;
+	int32_t tiles_x = (dim_im_out_x + 1) / 2;
+	int32_t tiles_y = (dim_im_out_y + 1) / 2;
+	q31_t m[4][16];
+
+	memset(zeros, 0, ch_im_in);
+
+	for (ty = 0; ty < tiles_y; ty++)
+	{
+		for (tx = 0; tx < tiles_x; tx += 2)
+		{
+			// the last tile of an odd row is paired with itself
+			bool pair = tx + 1 < tiles_x;
+			q15_t *Vb = pair ? V1 : V0;
+
+			winograd_input_tile(Im_in, dim_im_in_x, dim_im_in_y, ch_im_in,
+				tx * 2 - padding_x, ty * 2 - padding_y, zeros, V0);
+			if (pair)
+				winograd_input_tile(Im_in, dim_im_in_x, dim_im_in_y, ch_im_in,
+					tx * 2 + 2 - padding_x, ty * 2 - padding_y, zeros, V1);
+
+			for (k = 0; k < ch_im_out; k += 2)
+			{
+				// so is the last filter of an odd number
+				int32_t kb = k + 1 < ch_im_out ? k + 1 : k;
+				const q15_t *Ua = wt + k * 16 * ch_im_in;
+				const q15_t *Ub = wt + kb * 16 * ch_im_in;
+
+				for (xi = 0; xi < 16; xi++)
+				{
+					const q15_t *ua = Ua + xi * ch_im_in;
+					const q15_t *ub = Ub + xi * ch_im_in;
+					const q15_t *va = V0 + xi * ch_im_in;
+					const q15_t *vb = Vb + xi * ch_im_in;
+					q31_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+
+					c = 0;
+#if defined(NNOM_USING_CMSIS_NN) && defined(ARM_MATH_DSP)
+					for (; c + 2 <= ch_im_in; c += 2)
+					{
+						q31_t wa = arm_nn_read_q15x2(ua + c);
+						q31_t wb = arm_nn_read_q15x2(ub + c);
+						q31_t xa = arm_nn_read_q15x2(va + c);
+						q31_t xb = arm_nn_read_q15x2(vb + c);
+
+						s0 = __SMLAD(wa, xa, s0);
+						s1 = __SMLAD(wb, xa, s1);
+						s2 = __SMLAD(wa, xb, s2);
+						s3 = __SMLAD(wb, xb, s3);
+					}
+#endif
+					for (; c < ch_im_in; c++)
+					{
+						s0 += ua[c] * va[c];
+						s1 += ub[c] * va[c];
+						s2 += ua[c] * vb[c];
+						s3 += ub[c] * vb[c];
+					}
+					m[0][xi] = s0;
+					m[1][xi] = s1;
+					m[2][xi] = s2;
+					m[3][xi] = s3;
+				}
+
+				for (c = 0; c < 4; c++)
+				{
+					int32_t f = (c & 1) ? kb : k;
+#ifndef NNOM_TRUNCATE
+					q31_t base = ((q31_t)(bias[f]) << bias_shift) + (0x1 << (out_shift - 1));
+#else
+					q31_t base = (q31_t)bias[f] << bias_shift;
+#endif
+					if (((c & 1) && kb == k) || ((c & 2) && !pair))
+						continue;
+					winograd_output_tile(m[c], base, out_shift, Im_out + f, ch_im_out,
+						dim_im_out_x, dim_im_out_y, (tx + (c >> 1)) * 2, ty * 2);
+				}
+			}
+		}
+	}
+}
+
+// Block sparse kernels. A weight row (one output) keeps only its non-zero blocks of 4
+// consecutive weights, block_idx[] tells where a block starts in the input (in units of 4)
+// and the blocks of output o are row_ptr[o] to row_ptr[o+1]-1, see nnom_utils.py.
+// The input is widened to q15 once and padded with zeros to a multiple of 4, so the last
+// block never reads past it. With DSP every 4 inputs are stored as x0 x2 x1 x3, the order
+// __SXTB16 unpacks the q7 weights in: one block is then 1 weight load and 2 SMLAD.
+// Zero blocks are skipped, so time and weight memory follow the number of non-zero blocks.
+
+static void sparse_q7_to_q15(const q7_t *src, q15_t *dst, uint32_t len)
+{
+	uint32_t i;
+	uint32_t len4 = (len + 3) & ~3;
+
+	for (i = 0; i < len4; i++)
+	{
+		q15_t x = i < len ? src[i] : 0;
+#if defined(NNOM_USING_CMSIS_NN) && defined(ARM_MATH_DSP)
+		dst[(i & ~3) + ((i & 1) << 1) + ((i >> 1) & 1)] = x;
+#else
+		dst[i] = x;
+#endif
+	}
+}
+
+// the dim_kernel_y x dim_kernel_x x ch_im_in patch under output pixel (x, y), padding reads zeros.
+// The kernel taps are dilation_x/dilation_y pixels apart. The input is read as if it was up sampled
+// (nearest) upsample_x/upsample_y times, without making the larger image.
+// 1x1 without padding returns the input pixel itself when it is in the input, the others are gathered in patch
+static const q7_t *im2col_q7(const q7_t *Im_in,
+	const uint16_t dim_im_in_x, const uint16_t dim_im_in_y, const uint16_t ch_im_in,
+	const uint16_t dim_kernel_x, const uint16_t dim_kernel_y,
+	const uint16_t padding_x, const uint16_t padding_y, const uint16_t stride_x, const uint16_t stride_y,
+	const uint16_t dilation_x, const uint16_t dilation_y, const uint16_t upsample_x, const uint16_t upsample_y,
+	int32_t x, int32_t y, q7_t *patch)
+{
+	int32_t m, n, in_x, in_y;
+	q7_t *p = patch;
+
+	if (dim_kernel_x == 1 && dim_kernel_y == 1 && padding_x == 0 && padding_y == 0 && upsample_x == 1 && upsample_y == 1 &&
+		y * stride_y < dim_im_in_y && x * stride_x < dim_im_in_x)
+		return Im_in + (y * stride_y * dim_im_in_x + x * stride_x) * ch_im_in;
+
+	for (m = 0; m < dim_kernel_y; m++)
+	{
+		for (n = 0; n < dim_kernel_x; n++)
+		{
+			in_y = y * stride_y - padding_y + m * dilation_y;
+			in_x = x * stride_x - padding_x + n * dilation_x;
+			if (in_y >= 0 && in_x >= 0 && in_y < dim_im_in_y * upsample_y && in_x < dim_im_in_x * upsample_x)
+				memcpy(p, Im_in + (in_y / upsample_y * dim_im_in_x + in_x / upsample_x) * ch_im_in, ch_im_in);
+			else
+				memset(p, 0, ch_im_in);
+			p += ch_im_in;
+		}
+	}
+	return patch;
+}
+
+// two output pixels at a time, so each block of weights is unpacked once for both
+void local_convolve_HWC_q7_sparse(const q7_t *Im_in,                   // input image
+	const uint16_t dim_im_in_x,                                        // input image dimention x
+	const uint16_t dim_im_in_y,                                        // input image dimention y
+	const uint16_t ch_im_in,                                           // number of input image channels
+	const q7_t *wt,                                                    // values of the non-zero weight blocks
+	const uint16_t *block_idx,                                         // input offset of each block, in 4s
+	const uint32_t *row_ptr,                                           // first block of each filter, ch_im_out + 1 entries
+	const uint16_t ch_im_out,                                          // number of filters, i.e., output image channels
+	const uint16_t dim_kernel_x,                                       // filter kernel size x
+	const uint16_t dim_kernel_y,                                       // filter kernel size y
+	const uint16_t padding_x,                                          // padding sizes x
+	const uint16_t padding_y,                                          // padding sizes y
+	const uint16_t stride_x,                                           // stride x
+	const uint16_t stride_y,                                           // stride y
+	const uint16_t dilation_x,                                         // dilation x
+	const uint16_t dilation_y,                                         // dilation y
+	const q7_t *bias,                                                  // bias
+	const uint16_t bias_shift, const uint16_t out_shift, q7_t *Im_out, // output image
+	const uint16_t dim_im_out_x,                                       // output image dimension x
+	const uint16_t dim_im_out_y,                                       // output image dimension y
+	q15_t *bufferA)                                                    // size = 5*(ch_im_in*dim_kernel_x*dim_kernel_y rounded up to 4) bytes
+{
+	uint32_t len = ch_im_in * dim_kernel_x * dim_kernel_y;
+	uint32_t len4 = (len + 3) & ~3;
+	q15_t *col0 = bufferA;
+	q15_t *col1 = bufferA + len4;
+	q7_t *patch = (q7_t *)(bufferA + 2 * len4);
+	int32_t num = dim_im_out_x * dim_im_out_y;
+	int32_t i, k;
+	uint32_t b;
+
+	for (i = 0; i < num; i += 2)
+	{
+		// the last pixel of an odd number is paired with itself
+		bool pair = i + 1 < num;
+		const q15_t *c1 = pair ? col1 : col0;
+		q7_t *out = Im_out + i * ch_im_out;
+
+		sparse_q7_to_q15(im2col_q7(Im_in, dim_im_in_x, dim_im_in_y, ch_im_in, dim_kernel_x, dim_kernel_y,
+			padding_x, padding_y, stride_x, stride_y, dilation_x, dilation_y, 1, 1, i % dim_im_out_x, i / dim_im_out_x, patch), col0, len);
+		if (pair)
+			sparse_q7_to_q15(im2col_q7(Im_in, dim_im_in_x, dim_im_in_y, ch_im_in, dim_kernel_x, dim_kernel_y,
+				padding_x, padding_y, stride_x, stride_y, dilation_x, dilation_y, 1, 1, (i + 1) % dim_im_out_x, (i + 1) / dim_im_out_x, patch), col1, len);
+
+		for (k = 0; k < ch_im_out; k++)
+		{
+			const q7_t *w = wt + row_ptr[k] * 4;
+#ifndef NNOM_TRUNCATE
+			q31_t sum0 = ((q31_t)(bias[k]) << bias_shift) + (0x1 << (out_shift - 1));
+#else
+			q31_t sum0 = (q31_t)bias[k] << bias_shift;
+#endif
+			q31_t sum1 = sum0;
+
+			for (b = row_ptr[k]; b < row_ptr[k + 1]; b++)
+			{
+				const q15_t *x0 = col0 + block_idx[b] * 4;
+				const q15_t *x1 = c1 + block_idx[b] * 4;
+#if defined(NNOM_USING_CMSIS_NN) && defined(ARM_MATH_DSP)
+				q31_t w4 = arm_nn_read_q7x4(w);
+				q31_t w02 = __SXTB16(w4);
+				q31_t w13 = __SXTB16(__ROR(w4, 8));
+
+				sum0 = __SMLAD(w02, arm_nn_read_q15x2(x0), sum0);
+				sum0 = __SMLAD(w13, arm_nn_read_q15x2(x0 + 2), sum0);
+				sum1 = __SMLAD(w02, arm_nn_read_q15x2(x1), sum1);
+				sum1 = __SMLAD(w13, arm_nn_read_q15x2(x1 + 2), sum1);
+#else
+				sum0 += w[0] * x0[0] + w[1] * x0[1] + w[2] * x0[2] + w[3] * x0[3];
+				sum1 += w[0] * x1[0] + w[1] * x1[1] + w[2] * x1[2] + w[3] * x1[3];
+#endif
+				w += 4;
+			}
+			out[k] = (q7_t)__NNOM_SSAT((sum0 >> out_shift), 8);
+			if (pair)
+				out[ch_im_out + k] = (q7_t)__NNOM_SSAT((sum1 >> out_shift), 8);
+		}
+	}
+}
+
+// 4-bit weight kernels. Two weights share a byte, the first in the low nibble, and the weights of
+// each output are padded with zeros to a multiple of 8. The input is widened to q15 and padded the
+// same way. With DSP one 32-bit load gives 8 weights: masking the high nibbles and shifting the
+// low ones up turns them into q7 weights scaled by 16, which __SXTB16 unpacks to q15 pairs for
+// SMLAD. The input is stored as x0 x4 x2 x6 x1 x5 x3 x7 to match that order. The sum is 16 times
+// the real one and exact, >> 4 takes it back. The shifts are per output channel when given.
+
+static void int4_q7_to_q15(const q7_t *src, q15_t *dst, uint32_t len)
+{
+	uint32_t i;
+	uint32_t len8 = (len + 7) & ~7;
+
+	for (i = 0; i < len8; i++)
+	{
+		q15_t x = i < len ? src[i] : 0;
+#if defined(NNOM_USING_CMSIS_NN) && defined(ARM_MATH_DSP)
+		dst[(i & ~7) + ((i & 1) << 2) + (i & 2) + ((i >> 2) & 1)] = x;
+#else
+		dst[i] = x;
+#endif
+	}
+}
+
+// two output pixels at a time, so the weights are unpacked once for both
+void local_convolve_HWC_q7_int4(const q7_t *Im_in,                     // input image
+	const uint16_t dim_im_in_x,                                        // input image dimention x
+	const uint16_t dim_im_in_y,                                        // input image dimention y
+	const uint16_t ch_im_in,                                           // number of input image channels
+	const q7_t *wt,                                                    // packed 4-bit kernel weights
+	const uint16_t ch_im_out,                                          // number of filters, i.e., output image channels
+	const uint16_t dim_kernel_x,                                       // filter kernel size x
+	const uint16_t dim_kernel_y,                                       // filter kernel size y
+	const uint16_t padding_x,                                          // padding sizes x
+	const uint16_t padding_y,                                          // padding sizes y
+	const uint16_t stride_x,                                           // stride x
+	const uint16_t stride_y,                                           // stride y
+	const uint16_t dilation_x,                                         // dilation x
+	const uint16_t dilation_y,                                         // dilation y
+	const q7_t *bias,                                                  // bias
+	const uint16_t bias_shift, const uint16_t out_shift,               // shifts of the layer
+	const uint8_t *bias_shift_ch, const uint8_t *out_shift_ch,         // shifts of each filter, or NULL
+	q7_t *Im_out,                                                      // output image
+	const uint16_t dim_im_out_x,                                       // output image dimension x
+	const uint16_t dim_im_out_y,                                       // output image dimension y
+	q15_t *bufferA)                                                    // size = 5*(ch_im_in*dim_kernel_x*dim_kernel_y rounded up to 8) bytes
+{
+	uint32_t len = ch_im_in * dim_kernel_x * dim_kernel_y;
+	uint32_t len8 = (len + 7) & ~7;
+	q15_t *col0 = bufferA;
+	q15_t *col1 = bufferA + len8;
+	q7_t *patch = (q7_t *)(bufferA + 2 * len8);
+	int32_t num = dim_im_out_x * dim_im_out_y;
+	int32_t i, k;
+	uint32_t j;
+
+	for (i = 0; i < num; i += 2)
+	{
+		// the last pixel of an odd number is paired with itself
+		bool pair = i + 1 < num;
+		const q15_t *c1 = pair ? col1 : col0;
+		q7_t *out = Im_out + i * ch_im_out;
+
+		int4_q7_to_q15(im2col_q7(Im_in, dim_im_in_x, dim_im_in_y, ch_im_in, dim_kernel_x, dim_kernel_y,
+			padding_x, padding_y, stride_x, stride_y, dilation_x, dilation_y, 1, 1, i % dim_im_out_x, i / dim_im_out_x, patch), col0, len);
+		if (pair)
+			int4_q7_to_q15(im2col_q7(Im_in, dim_im_in_x, dim_im_in_y, ch_im_in, dim_kernel_x, dim_kernel_y,
+				padding_x, padding_y, stride_x, stride_y, dilation_x, dilation_y, 1, 1, (i + 1) % dim_im_out_x, (i + 1) / dim_im_out_x, patch), col1, len);
+
+		for (k = 0; k < ch_im_out; k++)
+		{
+			const q7_t *w = wt + k * len8 / 2;
+			const q15_t *x0 = col0;
+			const q15_t *x1 = c1;
+			uint16_t bs = bias_shift_ch ? bias_shift_ch[k] : bias_shift;
+			uint16_t os = out_shift_ch ? out_shift_ch[k] : out_shift;
+#ifndef NNOM_TRUNCATE
+			q31_t base = ((q31_t)(bias[k]) << bs) + (0x1 << (os - 1));
+#else
+			q31_t base = (q31_t)bias[k] << bs;
+#endif
+			q31_t sum0 = 0, sum1 = 0;
+
+#if defined(NNOM_USING_CMSIS_NN) && defined(ARM_MATH_DSP)
+			for (j = 0; j < len8; j += 8)
+			{
+				uint32_t w8 = (uint32_t)arm_nn_read_q7x4(w);
+				q31_t lo = (q31_t)((w8 << 4) & 0xF0F0F0F0);
+				q31_t hi = (q31_t)(w8 & 0xF0F0F0F0);
+				q31_t w04 = __SXTB16(lo);
+				q31_t w26 = __SXTB16(__ROR(lo, 8));
+				q31_t w15 = __SXTB16(hi);
+				q31_t w37 = __SXTB16(__ROR(hi, 8));
+
+				sum0 = __SMLAD(w04, arm_nn_read_q15x2(x0), sum0);
+				sum0 = __SMLAD(w26, arm_nn_read_q15x2(x0 + 2), sum0);
+				sum0 = __SMLAD(w15, arm_nn_read_q15x2(x0 + 4), sum0);
+				sum0 = __SMLAD(w37, arm_nn_read_q15x2(x0 + 6), sum0);
+				sum1 = __SMLAD(w04, arm_nn_read_q15x2(x1), sum1);
+				sum1 = __SMLAD(w26, arm_nn_read_q15x2(x1 + 2), sum1);
+				sum1 = __SMLAD(w15, arm_nn_read_q15x2(x1 + 4), sum1);
+				sum1 = __SMLAD(w37, arm_nn_read_q15x2(x1 + 6), sum1);
+				w += 4;
+				x0 += 8;
+				x1 += 8;
+			}
+			sum0 >>= 4;
+			sum1 >>= 4;
+#else
+			for (j = 0; j < len8; j += 2)
+			{
+				q7_t w0 = (q7_t)(*w << 4) >> 4;
+				q7_t w1 = *w++ >> 4;
+
+				sum0 += w0 * x0[0] + w1 * x0[1];
+				sum1 += w0 * x1[0] + w1 * x1[1];
+				x0 += 2;
+				x1 += 2;
+			}
+#endif
+			out[k] = (q7_t)__NNOM_SSAT(((sum0 + base) >> os), 8);
+			if (pair)
+				out[ch_im_out + k] = (q7_t)__NNOM_SSAT(((sum1 + base) >> os), 8);
+		}
+	}
+}
 
-    // find max amount results
-    for (int i = 0; i < output_size; i++)
-    {
-        int32_t val = buf[i];
-        if (val < 0)
-            val = -val;
-        if (val > max_abs)
-            max_abs = val;
-    }
-    // find best shift to cover the max
-    for (output_shift = 0;; output_shift++)
-    {
-        if (127 * (1 + output_shift) >= max_abs)
-            break;
-    }
+// one output pixel from its q7 patch, all filters
+static void conv_patch_q7(const q7_t *patch, const q7_t *wt, const uint16_t ch_im_out, const uint32_t len,
+	const q7_t *bias, const uint16_t bias_shift, const uint16_t out_shift, q7_t *out)
+{
+	uint32_t k, j;
 
-    // shift the results
-    for (int i = 0; i < output_size; i++)
-    {
-        Im_out[i] = buf[i] >> output_shift;
-    }
-    return output_shift;
+	for (k = 0; k < ch_im_out; k++)
+	{
+#ifndef NNOM_TRUNCATE
+		q31_t sum = ((q31_t)(bias[k]) << bias_shift) + (0x1 << (out_shift - 1));
+#else
+		q31_t sum = (q31_t)bias[k] << bias_shift;
+#endif
+		for (j = 0; j < len; j++)
+			sum += patch[j] * wt[j];
+		out[k] = (q7_t)__NNOM_SSAT((sum >> out_shift), 8);
+		wt += len;
+	}
 }
 
-// customised up sample pooling
-void local_up_sampling_q7_HWC(const q7_t *Im_in,       // input image
-	const uint16_t dim_im_in_x,  // input image dimension x or W
-	const uint16_t dim_im_in_y,  // input image dimension y or H
-	const uint16_t ch_im_in,     // number of input image channels
-	const uint16_t dim_kernel_x, // window kernel size
-	const uint16_t dim_kernel_y, // window kernel size
-	const uint16_t dim_im_out_x, // output image dimension x or W
-	const uint16_t dim_im_out_y, // output image dimension y or H
-	q7_t *bufferA,               // a buffer for local storage, NULL by now
-	q7_t *Im_out)
+// dilated convolution. The patches are gathered with their holes skipped, so the MACs are those of
+// the small kernel while the receptive field is (dim_kernel - 1) * dilation + 1 wide.
+// It also runs the convolution after a fused UpSample or ZeroPadding, on the input before them.
+// With DSP two pixels are widened to q15 side by side and go through the CMSIS-NN matrix kernel.
+void local_convolve_HWC_q7_dilated(const q7_t *Im_in,                  // input image
+	const uint16_t dim_im_in_x,                                        // input image dimention x
+	const uint16_t dim_im_in_y,                                        // input image dimention y
+	const uint16_t ch_im_in,                                           // number of input image channels
+	const q7_t *wt,                                                    // kernel weights
+	const uint16_t ch_im_out,                                          // number of filters, i.e., output image channels
+	const uint16_t dim_kernel_x,                                       // filter kernel size x
+	const uint16_t dim_kernel_y,                                       // filter kernel size y
+	const uint16_t padding_x,                                          // padding sizes x
+	const uint16_t padding_y,                                          // padding sizes y
+	const uint16_t stride_x,                                           // stride x
+	const uint16_t stride_y,                                           // stride y
+	const uint16_t dilation_x,                                         // dilation x
+	const uint16_t dilation_y,                                         // dilation y
+	const uint16_t upsample_x,                                         // nearest up sampling x of the input, 1 for none
+	const uint16_t upsample_y,                                         // nearest up sampling y of the input, 1 for none
+	const q7_t *bias,                                                  // bias
+	const uint16_t bias_shift, const uint16_t out_shift, q7_t *Im_out, // output image
+	const uint16_t dim_im_out_x,                                       // output image dimension x
+	const uint16_t dim_im_out_y,                                       // output image dimension y
+	q15_t *bufferA)                                                    // size = 5*ch_im_in*dim_kernel_x*dim_kernel_y bytes
 {
-    int16_t i_x, i_y;
-	
-    // for loop for each pixel in input image.
-    for (i_y = 0; i_y < dim_im_in_y; i_y++)
-    {
-        for (i_x = 0; i_x < dim_im_in_x; i_x++)
-        {
-            // copy all the channels together. 
-            const q7_t *p_in = Im_in + (i_y * dim_im_in_x + i_x ) * ch_im_in;
-            q7_t *pout = Im_out + (i_y * dim_im_in_x * dim_kernel_x * dim_kernel_y + i_x * dim_kernel_y) * ch_im_in;
-
-            // cpy along x axis
-            for(int i = 0; i<dim_kernel_x; i++)
-                memcpy(pout + i * ch_im_in, p_in, ch_im_in);
-            // duplicate the copied x data into y axis. 
-            for(int i = 1; i<dim_kernel_y-1; i++)
-                memcpy(pout + i * ch_im_in * dim_im_in_x * dim_kernel_x, pout, ch_im_in * dim_kernel_x);
-        }
-    }
+	uint32_t len = ch_im_in * dim_kernel_x * dim_kernel_y;
+	q7_t *patch = (q7_t *)(bufferA + 2 * len);
+	int32_t num = dim_im_out_x * dim_im_out_y;
+	int32_t i = 0;
+	q7_t *out = Im_out;
+
+#if defined(NNOM_USING_CMSIS_NN) && defined(ARM_MATH_DSP)
+	for (; i + 1 < num; i += 2)
+	{
+		arm_q7_to_q15_no_shift(im2col_q7(Im_in, dim_im_in_x, dim_im_in_y, ch_im_in, dim_kernel_x, dim_kernel_y,
+			padding_x, padding_y, stride_x, stride_y, dilation_x, dilation_y, upsample_x, upsample_y, i % dim_im_out_x, i / dim_im_out_x, patch), bufferA, len);
+		arm_q7_to_q15_no_shift(im2col_q7(Im_in, dim_im_in_x, dim_im_in_y, ch_im_in, dim_kernel_x, dim_kernel_y,
+			padding_x, padding_y, stride_x, stride_y, dilation_x, dilation_y, upsample_x, upsample_y, (i + 1) % dim_im_out_x, (i + 1) / dim_im_out_x, patch), bufferA + len, len);
+		out = arm_nn_mat_mult_kernel_q7_q15(wt, bufferA, ch_im_out, len, bias_shift, out_shift, bias, out);
+	}
+#endif
+	// the last pixel of an odd number, or all of them
+	for (; i < num; i++)
+	{
+		conv_patch_q7(im2col_q7(Im_in, dim_im_in_x, dim_im_in_y, ch_im_in, dim_kernel_x, dim_kernel_y,
+			padding_x, padding_y, stride_x, stride_y, dilation_x, dilation_y, upsample_x, upsample_y, i % dim_im_out_x, i / dim_im_out_x, patch),
+			wt, ch_im_out, len, bias, bias_shift, out_shift, out);
+		out += ch_im_out;
+	}
 }
 
-void local_up_sampling_q7_CHW(const q7_t *Im_in,       // input image
-	const uint16_t dim_im_in_x,  // input image dimension x or W
-	const uint16_t dim_im_in_y,  // input image dimension y or H
+// the channels of one input pixel are contiguous, so each tap is added to all the sums at once
+void local_depthwise_separable_conv_HWC_q7_dilated(const q7_t *Im_in,  // input image
+	const uint16_t dim_im_in_x,  // input image dimention x
+	const uint16_t dim_im_in_y,  // input image dimention y
 	const uint16_t ch_im_in,     // number of input image channels
-	const uint16_t dim_kernel_x, // window kernel size
-	const uint16_t dim_kernel_y, // window kernel size
-	const uint16_t dim_im_out_x, // output image dimension x or W
-	const uint16_t dim_im_out_y, // output image dimension y or H
-	q7_t *bufferA,               // a buffer for local storage, NULL by now
-	q7_t *Im_out)
+	const q7_t *wt,              // kernel weights
+	const uint16_t dim_kernel_x, // filter kernel size x
+	const uint16_t dim_kernel_y, // filter kernel size y
+	const uint16_t padding_x,    // padding sizes x
+	const uint16_t padding_y,    // padding sizes y
+	const uint16_t stride_x,     // stride x
+	const uint16_t stride_y,     // stride y
+	const uint16_t dilation_x,   // dilation x
+	const uint16_t dilation_y,   // dilation y
+	const q7_t *bias,            // bias
+	const uint16_t bias_shift,   // amount of left-shift for bias
+	const uint16_t out_shift,    // amount of right-shift for output
+	q7_t *Im_out,                // output image
+	const uint16_t dim_im_out_x, // output image dimension x
+	const uint16_t dim_im_out_y, // output image dimension y
+	q31_t *bufferA)              // size = 4*ch_im_in bytes
 {
-    int16_t i_x, i_y, ch;
-	// for loop for channel
-	for(ch=0; ch<ch_im_in; ch++)
+	int32_t i_out_y, i_out_x, i_ker_y, i_ker_x, in_row, in_col;
+	uint32_t c;
+
+	for (i_out_y = 0; i_out_y < dim_im_out_y; i_out_y++)
 	{
-		// for loop for each pixel in input image.
-		for (i_y = 0; i_y < dim_im_in_y; i_y++)
+		for (i_out_x = 0; i_out_x < dim_im_out_x; i_out_x++)
 		{
-			for (i_x = 0; i_x < dim_im_in_x; i_x++)
+			for (c = 0; c < ch_im_in; c++)
+#ifndef NNOM_TRUNCATE
+				bufferA[c] = ((q31_t)(bias[c]) << bias_shift) + (0x1 << (out_shift - 1));
+#else
+				bufferA[c] = (q31_t)bias[c] << bias_shift;
+#endif
+			for (i_ker_y = 0; i_ker_y < dim_kernel_y; i_ker_y++)
 			{
-				const q7_t *p_in = Im_in + ch * dim_im_in_x * dim_im_in_y + (i_y * dim_im_in_x + i_x);
-				q7_t *pout = Im_out + ch * dim_im_out_x * dim_im_out_y + (i_y * dim_im_in_x * dim_kernel_x * dim_kernel_y + i_x * dim_kernel_y);
-
-				// cpy along x axis
-				for(int i = 0; i<dim_kernel_x; i++)
-					*(pout + i) =  *p_in;
-				// duplicate the copied x data into y axis. 
-				for(int i = 1; i<dim_kernel_y-1; i++)
-					memcpy(pout + i * dim_im_in_x * dim_kernel_x, pout, dim_kernel_x);
+				in_row = stride_y * i_out_y + i_ker_y * dilation_y - padding_y;
+				if (in_row < 0 || in_row >= dim_im_in_y)
+					continue;
+				for (i_ker_x = 0; i_ker_x < dim_kernel_x; i_ker_x++)
+				{
+					const q7_t *in, *w;
+
+					in_col = stride_x * i_out_x + i_ker_x * dilation_x - padding_x;
+					if (in_col < 0 || in_col >= dim_im_in_x)
+						continue;
+					in = Im_in + (in_row * dim_im_in_x + in_col) * ch_im_in;
+					w = wt + (i_ker_y * dim_kernel_x + i_ker_x) * ch_im_in;
+					for (c = 0; c < ch_im_in; c++)
+						bufferA[c] += in[c] * w[c];
+				}
 			}
+			for (c = 0; c < ch_im_in; c++)
+				*Im_out++ = (q7_t)__NNOM_SSAT((bufferA[c] >> out_shift), 8);
 		}
 	}
 }
 
+// 1D convolution, dim_im_in pixels in a row. Without dilation the patch of an output is a
+// contiguous window of the input, it is widened or read in place and only the borders are gathered.
+// With DSP pairs of windows go through the CMSIS-NN matrix kernels, the reordered one when the
+// window is a multiple of 4 and the filters are even, as in arm_convolve_HWC_q7_fast_nonsquare().
+static const q7_t *window_1d_q7(const q7_t *Im_in, const uint16_t dim_im_in, const uint16_t ch_im_in,
+	const uint16_t dim_kernel, const uint16_t padding, const uint16_t stride, const uint16_t dilation,
+	int32_t i, q7_t *patch)
+{
+	int32_t start = i * stride - padding;
+
+	if (dilation == 1 && start >= 0 && start + dim_kernel <= dim_im_in)
+		return Im_in + start * ch_im_in;
+	return im2col_q7(Im_in, dim_im_in, 1, ch_im_in, dim_kernel, 1, padding, 0, stride, 1, dilation, 1, 1, 1, i, 0, patch);
+}
+
+void local_convolve_1D_HWC_q7(const q7_t *Im_in,                      // input signal
+	const uint16_t dim_im_in,                                          // input length
+	const uint16_t ch_im_in,                                           // number of input channels
+	const q7_t *wt,                                                    // kernel weights
+	const uint16_t ch_im_out,                                          // number of filters, i.e., output channels
+	const uint16_t dim_kernel,                                         // filter kernel size
+	const uint16_t padding,                                            // padding sizes
+	const uint16_t stride,                                             // stride
+	const uint16_t dilation,                                           // dilation
+	const q7_t *bias,                                                  // bias
+	const uint16_t bias_shift, const uint16_t out_shift, q7_t *Im_out, // output signal
+	const uint16_t dim_im_out,                                         // output length
+	q15_t *bufferA)                                                    // size = 5*ch_im_in*dim_kernel bytes
+{
+	uint32_t len = ch_im_in * dim_kernel;
+	q7_t *patch = (q7_t *)(bufferA + 2 * len);
+	int32_t i = 0;
+	q7_t *out = Im_out;
 
-void local_convolve_HWC_q7_nonsquare(const q7_t *Im_in,                // input image
+#if defined(NNOM_USING_CMSIS_NN) && defined(ARM_MATH_DSP)
+	if (len % 4 == 0 && ch_im_out % 2 == 0)
+	{
+		for (; i + 1 < dim_im_out; i += 2)
+		{
+			arm_q7_to_q15_reordered_no_shift(window_1d_q7(Im_in, dim_im_in, ch_im_in, dim_kernel,
+				padding, stride, dilation, i, patch), bufferA, len);
+			arm_q7_to_q15_reordered_no_shift(window_1d_q7(Im_in, dim_im_in, ch_im_in, dim_kernel,
+				padding, stride, dilation, i + 1, patch), bufferA + len, len);
+			out = arm_nn_mat_mult_kernel_q7_q15_reordered(wt, bufferA, ch_im_out, len, bias_shift, out_shift, bias, out);
+		}
+	}
+	else
+	{
+		for (; i + 1 < dim_im_out; i += 2)
+		{
+			arm_q7_to_q15_no_shift(window_1d_q7(Im_in, dim_im_in, ch_im_in, dim_kernel,
+				padding, stride, dilation, i, patch), bufferA, len);
+			arm_q7_to_q15_no_shift(window_1d_q7(Im_in, dim_im_in, ch_im_in, dim_kernel,
+				padding, stride, dilation, i + 1, patch), bufferA + len, len);
+			out = arm_nn_mat_mult_kernel_q7_q15(wt, bufferA, ch_im_out, len, bias_shift, out_shift, bias, out);
+		}
+	}
+#endif
+	// the last output of an odd number, or all of them
+	for (; i < dim_im_out; i++)
+	{
+		conv_patch_q7(window_1d_q7(Im_in, dim_im_in, ch_im_in, dim_kernel, padding, stride, dilation, i, patch),
+			wt, ch_im_out, len, bias, bias_shift, out_shift, out);
+		out += ch_im_out;
+	}
+}
+
+// same as local_convolve_HWC_q7_nonsquare() but only computes the outputs inside
+// [out_x_start, out_x_end) x [out_y_start, out_y_end), the rest of Im_out is left untouched.
+// All filters of one output pixel are done together so its input patch stays in cache.
+void local_convolve_HWC_q7_region(const q7_t *Im_in,             // input image
 	const uint16_t dim_im_in_x,                                        // input image dimention x
 	const uint16_t dim_im_in_y,                                        // input image dimention y
 	const uint16_t ch_im_in,                                           // number of input image channels
@@ -437,42 +1497,49 @@ void local_convolve_HWC_q7_nonsquare(const q7_t *Im_in,                // input
 	const q7_t *bias,                                                  // bias
 	const uint16_t bias_shift, const uint16_t out_shift, q7_t *Im_out, // output image
 	const uint16_t dim_im_out_x,                                       // output image dimension x
-	const uint16_t dim_im_out_y,                                       // output image dimension y
-	q15_t *bufferA,                                                    //buffer space for input
-	q7_t *bufferB                                                      //buffer space for output
+	const uint16_t out_x_start,                                        // first output column to compute
+	const uint16_t out_x_end,                                          // one past the last output column
+	const uint16_t out_y_start,                                        // first output row to compute
+	const uint16_t out_y_end                                           // one past the last output row
 )
 {
-    int i, j, k, l, m, n;
+    int i, j, k, m, n;
     int conv_out;
-    int in_row, in_col;
+    int m_start, m_end, n_start, n_end;
+    const q7_t *in_pixel;
+    const q7_t *wt_pixel;
+    const uint32_t wt_size = ch_im_in * dim_kernel_y * dim_kernel_x;
 
-    for (i = 0; i < ch_im_out; i++)
+    for (j = out_y_start; j < out_y_end; j++)
     {
-        for (j = 0; j < dim_im_out_y; j++)
+        // kernel rows which fall inside the image
+        m_start = padding_y - stride_y * j;
+        m_start = m_start > 0 ? m_start : 0;
+        m_end = dim_im_in_y + padding_y - stride_y * j;
+        m_end = m_end < dim_kernel_y ? m_end : dim_kernel_y;
+
+        for (k = out_x_start; k < out_x_end; k++)
         {
-            for (k = 0; k < dim_im_out_x; k++)
+            n_start = padding_x - stride_x * k;
+            n_start = n_start > 0 ? n_start : 0;
+            n_end = dim_im_in_x + padding_x - stride_x * k;
+            n_end = n_end < dim_kernel_x ? n_end : dim_kernel_x;
+
+            for (i = 0; i < ch_im_out; i++)
             {
 #ifndef NNOM_TRUNCATE
                 conv_out = ((q31_t)(bias[i]) << bias_shift) + (0x1 << (out_shift - 1));
 #else
                 conv_out = bias[i] << bias_shift;
 #endif
-                for (m = 0; m < dim_kernel_y; m++)
+                for (m = m_start; m < m_end; m++)
                 {
-                    for (n = 0; n < dim_kernel_x; n++)
+                    // kernel row m is contiguous in both the input and the weights
+                    in_pixel = Im_in + ((stride_y * j + m - padding_y) * dim_im_in_x + stride_x * k + n_start - padding_x) * ch_im_in;
+                    wt_pixel = wt + i * wt_size + (m * dim_kernel_x + n_start) * ch_im_in;
+                    for (n = 0; n < (n_end - n_start) * ch_im_in; n++)
                     {
-                        // if-for implementation
-                        in_row = stride_y * j + m - padding_y;
-                        in_col = stride_x * k + n - padding_x;
-                        if (in_row >= 0 && in_col >= 0 && in_row < dim_im_in_y && in_col < dim_im_in_x)
-                        {
-                            for (l = 0; l < ch_im_in; l++)
-                            {
-                                conv_out += Im_in[(in_row * dim_im_in_x + in_col) * ch_im_in + l] *
-                                            wt[i * ch_im_in * dim_kernel_y * dim_kernel_x + (m * dim_kernel_x + n) * ch_im_in +
-                                               l];
-                            }
-                        }
+                        conv_out += in_pixel[n] * wt_pixel[n];
                     }
                 }
                 Im_out[i + (j * dim_im_out_x + k) * ch_im_out] = (q7_t)__NNOM_SSAT((conv_out >> out_shift), 8);
@@ -481,7 +1548,6 @@ void local_convolve_HWC_q7_nonsquare(const q7_t *Im_in,                // input
     }
 }
 
-
 void local_convolve_CHW_q7_nonsquare(const q7_t *Im_in,                // input image
 	const uint16_t dim_im_in_x,                                        // input image dimention x
 	const uint16_t dim_im_in_y,                                        // input image dimention y
@@ -494,6 +1560,8 @@ void local_convolve_CHW_q7_nonsquare(const q7_t *Im_in,                // input
 	const uint16_t padding_y,                                          // padding sizes y
 	const uint16_t stride_x,                                           // stride x
 	const uint16_t stride_y,                                           // stride y
+	const uint16_t dilation_x,                                         // dilation x
+	const uint16_t dilation_y,                                         // dilation y
 	const q7_t *bias,                                                  // bias
 	const uint16_t bias_shift, const uint16_t out_shift, q7_t *Im_out, // output image
 	const uint16_t dim_im_out_x,                                       // output image dimension x
@@ -522,8 +1590,8 @@ void local_convolve_CHW_q7_nonsquare(const q7_t *Im_in,                // input
 					for (n = 0; n < dim_kernel_x; n++)
 					{
 						// if-for implementation
-						in_row = stride_y * j + m - padding_y;
-						in_col = stride_x * k + n - padding_x;
+						in_row = stride_y * j + m * dilation_y - padding_y;
+						in_col = stride_x * k + n * dilation_x - padding_x;
 						if (in_row >= 0 && in_col >= 0 && in_row < dim_im_in_y && in_col < dim_im_in_x)
 						{
 							for (l = 0; l < ch_im_in; l++)
@@ -609,6 +1677,8 @@ void local_depthwise_separable_conv_CHW_q7_nonsquare(const q7_t *Im_in,
 	const uint16_t padding_y,    // padding sizes y
 	const uint16_t stride_x,     // stride x
 	const uint16_t stride_y,     // stride y
+	const uint16_t dilation_x,   // dilation x
+	const uint16_t dilation_y,   // dilation y
 	const q7_t *bias,            // bias
 	const uint16_t bias_shift,   // amount of left-shift for bias
 	const uint16_t out_shift,    // amount of right-shift for output
@@ -638,8 +1708,8 @@ void local_depthwise_separable_conv_CHW_q7_nonsquare(const q7_t *Im_in,
 					for (i_ker_x = 0; i_ker_x < dim_kernel_x; i_ker_x++)
 					{
 						// if-for implementation
-						int in_row = stride_y * i_out_y + i_ker_y - padding_y;
-						int in_col = stride_x * i_out_x + i_ker_x - padding_x;
+						int in_row = stride_y * i_out_y + i_ker_y * dilation_y - padding_y;
+						int in_col = stride_x * i_out_x + i_ker_x * dilation_x - padding_x;
 						if (in_row >= 0 && in_col >= 0 && in_row < dim_im_in_y && in_col < dim_im_in_x)
 						{
 							conv_out += Im_in[(in_row * dim_im_in_x + in_col) + i_ch_out * dim_im_in_x * dim_im_in_y] *
@@ -728,7 +1798,7 @@ void local_zero_padding_CHW_q7(const q7_t *Im_in,           // input image
 			memcpy(p_out, Im_in + i*dim_im_in_x + ch_offset, dim_im_in_x);
 			p_out += dim_im_in_x;
 			// right - set to 0
-			memset(p_out, 0, size); 
+			memset(p_out, 0, padding_right); 
 			p_out += padding_right;
 		}
 		// bottom
@@ -801,6 +1871,55 @@ void local_cropping_CHW_q7(const q7_t *Im_in,           // input image
 	}	
 }
 
+void local_batchnorm_q7_HWC(const q7_t *Im_in, // input image
+	const uint16_t ch_im_in,    // number of input image channels
+	const uint32_t dim_im_in,   // number of pixels
+	const q7_t *scale,          // scale of each channel
+	const q7_t *bias,           // offset of each channel
+	const uint16_t bias_shift,  // amount of left-shift for bias
+	const uint16_t out_shift,   // amount of right-shift for output
+	q7_t *Im_out)               // output image
+{
+	for (uint32_t i = 0; i < dim_im_in; i++)
+	{
+		for (int c = 0; c < ch_im_in; c++)
+		{
+#ifndef NNOM_TRUNCATE
+			q31_t sum = ((q31_t)bias[c] << bias_shift) + (0x1 << (out_shift - 1));
+#else
+			q31_t sum = (q31_t)bias[c] << bias_shift;
+#endif
+			sum += Im_in[c] * scale[c];
+			Im_out[c] = (q7_t)__NNOM_SSAT((sum >> out_shift), 8);
+		}
+		Im_in += ch_im_in;
+		Im_out += ch_im_in;
+	}
+}
+
+void local_batchnorm_q7_CHW(const q7_t *Im_in, // input image
+	const uint16_t ch_im_in,    // number of input image channels
+	const uint32_t dim_im_in,   // number of pixels
+	const q7_t *scale,          // scale of each channel
+	const q7_t *bias,           // offset of each channel
+	const uint16_t bias_shift,  // amount of left-shift for bias
+	const uint16_t out_shift,   // amount of right-shift for output
+	q7_t *Im_out)               // output image
+{
+	for (int c = 0; c < ch_im_in; c++)
+	{
+#ifndef NNOM_TRUNCATE
+		q31_t base = ((q31_t)bias[c] << bias_shift) + (0x1 << (out_shift - 1));
+#else
+		q31_t base = (q31_t)bias[c] << bias_shift;
+#endif
+		for (uint32_t i = 0; i < dim_im_in; i++)
+			Im_out[i] = (q7_t)__NNOM_SSAT(((base + Im_in[i] * scale[c]) >> out_shift), 8);
+		Im_in += dim_im_in;
+		Im_out += dim_im_in;
+	}
+}
+
 void local_fully_connected_q7_opt(const q7_t *pV,               // pointer to vector
 	const q7_t *pM,               // pointer to matrix
 	const uint16_t dim_vec,       // length of the vector
@@ -945,13 +2064,113 @@ void local_fully_connected_q7(const q7_t *pV,               // pointer to vector
 }
 
 
+// block sparse fully connected, see local_convolve_HWC_q7_sparse() for the weight format
+void local_fully_connected_q7_sparse(const q7_t *pV, // pointer to vector
+	const q7_t *pM,               // values of the non-zero weight blocks
+	const uint16_t *block_idx,    // input offset of each block, in 4s
+	const uint32_t *row_ptr,      // first block of each row, num_of_rows + 1 entries
+	const uint16_t dim_vec,       // length of the vector
+	const uint16_t num_of_rows,   // numCol of A
+	const uint16_t bias_shift,    // amount of left-shift for bias
+	const uint16_t out_shift,     // amount of right-shift for output
+	const q7_t *bias, q7_t *pOut, // output operand
+	q15_t *vec_buffer)            // size = 2*(dim_vec rounded up to 4) bytes
+{
+	const q7_t *w = pM;
+	uint32_t b;
+
+	sparse_q7_to_q15(pV, vec_buffer, dim_vec);
+
+	for (int i = 0; i < num_of_rows; i++)
+	{
+#ifndef NNOM_TRUNCATE
+		q31_t ip_out = ((q31_t)(bias[i]) << bias_shift) + (0x1 << (out_shift - 1));
+#else
+		q31_t ip_out = (q31_t)bias[i] << bias_shift;
+#endif
+		for (b = row_ptr[i]; b < row_ptr[i + 1]; b++)
+		{
+			const q15_t *x = vec_buffer + block_idx[b] * 4;
+#if defined(NNOM_USING_CMSIS_NN) && defined(ARM_MATH_DSP)
+			q31_t w4 = arm_nn_read_q7x4(w);
+
+			ip_out = __SMLAD(__SXTB16(w4), arm_nn_read_q15x2(x), ip_out);
+			ip_out = __SMLAD(__SXTB16(__ROR(w4, 8)), arm_nn_read_q15x2(x + 2), ip_out);
+#else
+			ip_out += w[0] * x[0] + w[1] * x[1] + w[2] * x[2] + w[3] * x[3];
+#endif
+			w += 4;
+		}
+		pOut[i] = (q7_t)__NNOM_SSAT((ip_out >> out_shift), 8);
+	}
+}
+
+
+// 4-bit fully connected, see local_convolve_HWC_q7_int4() for the weight format
+void local_fully_connected_q7_int4(const q7_t *pV, // pointer to vector
+	const q7_t *pM,               // packed 4-bit weights, each row padded to 8
+	const uint16_t dim_vec,       // length of the vector
+	const uint16_t num_of_rows,   // numCol of A
+	const uint16_t bias_shift,    // amount of left-shift for bias
+	const uint16_t out_shift,     // amount of right-shift for output
+	const uint8_t *bias_shift_ch, // left-shift of each bias, or NULL
+	const uint8_t *out_shift_ch,  // right-shift of each output, or NULL
+	const q7_t *bias, q7_t *pOut, // output operand
+	q15_t *vec_buffer)            // size = 2*(dim_vec rounded up to 8) bytes
+{
+	uint32_t len8 = (dim_vec + 7) & ~7;
+	const q7_t *w = pM;
+	uint32_t j;
+
+	int4_q7_to_q15(pV, vec_buffer, dim_vec);
+
+	for (int i = 0; i < num_of_rows; i++)
+	{
+		const q15_t *x = vec_buffer;
+		uint16_t bs = bias_shift_ch ? bias_shift_ch[i] : bias_shift;
+		uint16_t os = out_shift_ch ? out_shift_ch[i] : out_shift;
+		q31_t ip_out = 0;
+
+#if defined(NNOM_USING_CMSIS_NN) && defined(ARM_MATH_DSP)
+		for (j = 0; j < len8; j += 8)
+		{
+			uint32_t w8 = (uint32_t)arm_nn_read_q7x4(w);
+			q31_t lo = (q31_t)((w8 << 4) & 0xF0F0F0F0);
+			q31_t hi = (q31_t)(w8 & 0xF0F0F0F0);
+
+			ip_out = __SMLAD(__SXTB16(lo), arm_nn_read_q15x2(x), ip_out);
+			ip_out = __SMLAD(__SXTB16(__ROR(lo, 8)), arm_nn_read_q15x2(x + 2), ip_out);
+			ip_out = __SMLAD(__SXTB16(hi), arm_nn_read_q15x2(x + 4), ip_out);
+			ip_out = __SMLAD(__SXTB16(__ROR(hi, 8)), arm_nn_read_q15x2(x + 6), ip_out);
+			w += 4;
+			x += 8;
+		}
+		ip_out >>= 4;
+#else
+		for (j = 0; j < len8; j += 2)
+		{
+			ip_out += ((q7_t)(*w << 4) >> 4) * x[0] + (*w >> 4) * x[1];
+			w++;
+			x += 2;
+		}
+#endif
+#ifndef NNOM_TRUNCATE
+		ip_out += ((q31_t)(bias[i]) << bs) + (0x1 << (os - 1));
+#else
+		ip_out += (q31_t)bias[i] << bs;
+#endif
+		pOut[i] = (q7_t)__NNOM_SSAT((ip_out >> os), 8);
+	}
+}
+
+
 void local_softmax_q7(const q7_t *vec_in, const uint32_t dim_vec, q7_t *p_out)
 {
     q31_t sum;
     int32_t i;
     uint8_t shift;
     q15_t base;
-    base = -257;
+    base = -128;
 
     /* We first search for the maximum */
     for (i = 0; i < dim_vec; i++)
@@ -971,13 +2190,14 @@ void local_softmax_q7(const q7_t *vec_in, const uint32_t dim_vec, q7_t *p_out)
 
     sum = 0;
 
+    /* 
+     * Same arithmetic as arm_softmax_q7() in CMSIS-NN 5, so both backends give the 
+     * same output: the shift saturates at 7 and every value counts at least 1. 
+     */
     for (i = 0; i < dim_vec; i++)
     {
-        if (vec_in[i] > base)
-        {
-            shift = (uint8_t)__NNOM_USAT(vec_in[i] - base, 5);
-            sum += 0x1 << shift;
-        }
+        shift = (uint8_t)__NNOM_USAT(vec_in[i] - base, 3);
+        sum += 0x1 << shift;
     }
 
     /* This is effectively (0x1 << 20) / sum */
@@ -990,88 +2210,66 @@ void local_softmax_q7(const q7_t *vec_in, const uint32_t dim_vec, q7_t *p_out)
      */
     for (i = 0; i < dim_vec; i++)
     {
-        if (vec_in[i] > base)
-        {
-            /* Here minimum value of 13+base-vec_in[i] will be 5 */
-            shift = (uint8_t)__NNOM_USAT(13 + base - vec_in[i], 5);
-            p_out[i] = (q7_t)__NNOM_SSAT((output_base >> shift), 8);
-        }
-        else
-        {
-            p_out[i] = 0;
-        }
+        /* Here minimum value of 13+base-vec_in[i] will be 5 */
+        shift = (uint8_t)__NNOM_USAT(13 + base - vec_in[i], 5);
+        p_out[i] = (q7_t)__NNOM_SSAT((output_base >> shift), 8);
     }
 }
 
-void local_sigmoid_q7(q7_t * data, uint32_t size, int16_t int_width)
+// look up the table of the integer width, the inputs out of Q0.7 to Q7.0 are moved to the nearest one
+static void local_table_q7(q7_t *data, uint32_t size, int16_t int_width, const q7_t table[][256])
 {
-    uint32_t i = size;
-    q7_t *pIn = data;
-    q7_t *pOut = data;
-    q7_t in;
-    q7_t out;
-    uint16_t shift_size = 3 - int_width;
-	// saturation if int bit too large
-	if(int_width > 3)
+	const q7_t *lut;
+	uint32_t i;
+
+	if (int_width < 0 || int_width > 7)
 	{
-		while (i)
+		for (i = 0; i < size; i++)
 		{
-			if(*pIn++ > 0)
-				*pOut++ = 127;
+			if (int_width < 0)
+				data[i] = data[i] >> -int_width;
 			else
-				*pOut++ = 0;
-			i--;
+				data[i] = (q7_t)__NNOM_SSAT((q31_t)data[i] << (int_width - 7), 8);
 		}
+		int_width = int_width < 0 ? 0 : 7;
 	}
-	// otherwise search table
-	else
-	{
-		while (i)
-		{
-			in = *pIn++;
-			out = nnom_sigmoid_table_q7[(uint8_t)(in >> shift_size)];
-			*pOut++ = out;
-			i--;
-		}
-    }
-}
+	lut = table[int_width];
 
-void local_tanh_q7(q7_t *data, uint32_t size, int16_t int_width)
-{
-    uint32_t i = size;
-    q7_t *pIn = data;
-    q7_t *pOut = data;
-    q7_t in;
-	q7_t out;
-	uint16_t shift_size = 3 - int_width;
-	
-	// saturation if int bit too large
-	if(int_width > 3)
+	// 4 at a time, the same cost whatever the input is
+	i = size >> 2;
+	while (i)
 	{
-		while (i)
-		{
-			in = *pIn++;
-			if(in > 0)
-				*pOut++ = 127;
-			else if ( in == 0)
-				*pOut++ = 0;
-			else
-				*pOut++ = -128;
-			i--;
-		}
+		q7_t in1 = data[0];
+		q7_t in2 = data[1];
+		q7_t in3 = data[2];
+		q7_t in4 = data[3];
+
+		data[0] = lut[(uint8_t)in1];
+		data[1] = lut[(uint8_t)in2];
+		data[2] = lut[(uint8_t)in3];
+		data[3] = lut[(uint8_t)in4];
+		data += 4;
+		i--;
 	}
-	// otherwise search table
-	else
+	i = size & 0x3;
+	while (i)
 	{
-		while (i)
-		{
-			in = *pIn++;
-			out = nnom_tanh_table_q7[(uint8_t)(in >> shift_size)];
-			*pOut++ = out;
-			i--;
-		}
+		*data = lut[(uint8_t)*data];
+		data++;
+		i--;
 	}
 }
+
+void local_sigmoid_q7(q7_t * data, uint32_t size, int16_t int_width)
+{
+	local_table_q7(data, size, int_width, nnom_sigmoid_table_q7);
+}
+
+void local_tanh_q7(q7_t *data, uint32_t size, int16_t int_width)
+{
+	local_table_q7(data, size, int_width, nnom_tanh_table_q7);
+}
+
 void local_relu_q7(q7_t *data, uint32_t size)
 {
     uint32_t i;
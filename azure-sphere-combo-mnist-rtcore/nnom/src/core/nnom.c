@@ -992,16 +992,17 @@ nnom_status_t layer_run(nnom_layer_t *layer)
 	return result;
 }
 
-// run the model, until the end_layer. If end_layer == NULL, run all layers.
-nnom_status_t model_run_to(nnom_model_t *m, nnom_layer_t *end_layer)
+// run the layers from start_layer until the end_layer, in shortcut order. If end_layer == NULL, run till the end.
+// the output of the layer before start_layer must already be in its buffer (e.g. computed by another core)
+nnom_status_t model_run_range(nnom_model_t *m, nnom_layer_t *start_layer, nnom_layer_t *end_layer)
 {
 	uint32_t layer_num = 1;
 	nnom_status_t result;
 	nnom_layer_t *layer;
 	NNOM_NULL_CHECK(m);
-	NNOM_NULL_CHECK(m->head);
+	NNOM_NULL_CHECK(start_layer);
 
-	layer = m->head;
+	layer = start_layer;
 	
 	// using shortcut run
 	while (layer)
@@ -1019,7 +1020,9 @@ nnom_status_t model_run_to(nnom_model_t *m, nnom_layer_t *end_layer)
 			result = m->layer_callback(m, layer);
 			if (result != NN_SUCCESS)
 			{
-				NNOM_LOG("Error: Callback return error code %d at #%d %s layer\n", result, layer_num, default_layer_names[layer->type]);
+				// NN_MORE_TODO stops the run on purpose, e.g. a scheduler giving the core to another model
+				if (result != NN_MORE_TODO)
+					NNOM_LOG("Error: Callback return error code %d at #%d %s layer\n", result, layer_num, default_layer_names[layer->type]);
 				return result;
 			}
 		}		
@@ -1033,6 +1036,14 @@ nnom_status_t model_run_to(nnom_model_t *m, nnom_layer_t *end_layer)
 	return NN_SUCCESS;
 }
 
+// run the model, until the end_layer. If end_layer == NULL, run all layers.
+nnom_status_t model_run_to(nnom_model_t *m, nnom_layer_t *end_layer)
+{
+	NNOM_NULL_CHECK(m);
+	NNOM_NULL_CHECK(m->head);
+	return model_run_range(m, m->head, end_layer);
+}
+
 // run all layers.
 nnom_status_t model_run(nnom_model_t *m)
 {
@@ -0,0 +1,449 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "nnom.h"
+#include "nnom_local.h"
+#include "nnom_layers.h"
+#include "nnom_delta.h"
+
+nnom_status_t layer_run(nnom_layer_t *layer);
+
+// a changed area above 1/DELTA_FULL_RATIO of a Conv2D output is recomputed by the layer's
+// own run method (CMSIS-NN when enabled), which is faster per pixel than the region kernel
+#define DELTA_FULL_RATIO	2
+
+static int32_t rect_area(nnom_delta_rect_t *r)
+{
+	if (r->x0 >= r->x1 || r->y0 >= r->y1)
+		return 0;
+	return (int32_t)(r->x1 - r->x0) * (r->y1 - r->y0);
+}
+
+static nnom_delta_rect_t rect_full(nnom_tensor_t *t)
+{
+	nnom_delta_rect_t r = {0, 0, t->dim[1], t->dim[0]};
+	return r;
+}
+
+// output o of a window layer reads inputs [o*s - p, o*s - p + k),
+// find the outputs whose window overlaps the changed inputs [a, b)
+static void propagate_axis(int16_t a, int16_t b, int16_t k, int16_t s, int16_t p, int16_t dim_out,
+						   int16_t *o0, int16_t *o1)
+{
+	int32_t lo = a + p - k;
+
+	*o0 = lo < 0 ? 0 : lo / s + 1;
+	*o1 = (b + p + s - 1) / s;
+	if (*o1 > dim_out)
+		*o1 = dim_out;
+}
+
+static nnom_delta_rect_t propagate(nnom_delta_rect_t *in, nnom_shape_t k, nnom_shape_t s, nnom_shape_t p,
+								   nnom_tensor_t *out)
+{
+	nnom_delta_rect_t r = {0, 0, 0, 0};
+
+	if (rect_area(in) == 0)
+		return r;
+	propagate_axis(in->x0, in->x1, k.w, s.w, p.w, out->dim[1], &r.x0, &r.x1);
+	propagate_axis(in->y0, in->y1, k.h, s.h, p.h, out->dim[0], &r.y0, &r.y1);
+	return r;
+}
+
+// run an element-wise activation on a rectangle of a HWC tensor only
+static void act_region(nnom_activation_t *act, nnom_tensor_t *t, nnom_delta_rect_t *r)
+{
+	uint32_t row = t->dim[1] * t->dim[2];
+
+	if (rect_area(r) == 0)
+		return;
+
+	// full width rows are contiguous
+	if (r->x0 == 0 && r->x1 == t->dim[1])
+	{
+		act->data = (q7_t *)t->p_data + r->y0 * row;
+		act->size = (r->y1 - r->y0) * row;
+		act->run(act);
+	}
+	else
+	{
+		for (int16_t y = r->y0; y < r->y1; y++)
+		{
+			act->data = (q7_t *)t->p_data + y * row + r->x0 * t->dim[2];
+			act->size = (r->x1 - r->x0) * t->dim[2];
+			act->run(act);
+		}
+	}
+
+	// as set by the compiler, for a normal model_run()
+	act->data = t->p_data;
+	act->size = tensor_size(t);
+}
+
+// changed pixels between the new input and the cached one
+static nnom_delta_rect_t input_diff(const q7_t *p_new, const q7_t *p_old, nnom_tensor_t *t)
+{
+	nnom_delta_rect_t r = {t->dim[1], t->dim[0], 0, 0};
+	uint32_t ch = t->dim[2];
+	uint32_t row = t->dim[1] * ch;
+
+	for (int16_t y = 0; y < t->dim[0]; y++)
+	{
+		const q7_t *a = p_new + y * row;
+		const q7_t *b = p_old + y * row;
+
+		if (memcmp(a, b, row) == 0)
+			continue;
+
+		for (int16_t x = 0; x < t->dim[1]; x++)
+		{
+			if (memcmp(&a[x * ch], &b[x * ch], ch) != 0)
+			{
+				if (x < r.x0) r.x0 = x;
+				if (x >= r.x1) r.x1 = x + 1;
+			}
+		}
+		if (y < r.y0) r.y0 = y;
+		r.y1 = y + 1;
+	}
+	return r;
+}
+
+static nnom_delta_rect_t input_update(nnom_delta_t *d, nnom_layer_t *layer)
+{
+	nnom_io_layer_t *cl = (nnom_io_layer_t *)layer;
+	nnom_tensor_t *t = layer->in->tensor;
+	uint32_t row = t->dim[1] * t->dim[2];
+	nnom_delta_rect_t r;
+
+	if (d->valid)
+		r = input_diff(cl->buf, t->p_data, t);
+	else
+		r = rect_full(t);
+
+	if (rect_area(&r) > 0)
+		memcpy((q7_t *)t->p_data + r.y0 * row, (q7_t *)cl->buf + r.y0 * row, (r.y1 - r.y0) * row);
+	return r;
+}
+
+static nnom_delta_rect_t conv2d_update(nnom_layer_t *layer, nnom_delta_rect_t *in_rect)
+{
+	nnom_conv2d_layer_t *cl = (nnom_conv2d_layer_t *)layer;
+	nnom_tensor_t *in = layer->in->tensor;
+	nnom_tensor_t *out = layer->out->tensor;
+	nnom_delta_rect_t r = propagate(in_rect, cl->kernel, cl->stride, cl->pad, out);
+	nnom_delta_rect_t full = rect_full(out);
+
+	if (rect_area(&r) == 0)
+		return r;
+
+	// outputs outside r come out the same, so r is still what the next layer needs to redo
+	if (rect_area(&r) * DELTA_FULL_RATIO > rect_area(&full))
+	{
+		layer->run(layer);
+		if (layer->actail != NULL)
+			layer->actail->run(layer->actail);
+		return r;
+	}
+
+	local_convolve_HWC_q7_region(
+		in->p_data, in->dim[1], in->dim[0], in->dim[2],
+		cl->weights->p_value, out->dim[2],
+		cl->kernel.w, cl->kernel.h, cl->pad.w, cl->pad.h, cl->stride.w, cl->stride.h,
+		cl->bias->p_value, cl->bias_shift, cl->output_shift,
+		out->p_data, out->dim[1],
+		r.x0, r.x1, r.y0, r.y1);
+	if (layer->actail != NULL)
+		act_region(layer->actail, out, &r);
+	return r;
+}
+
+static nnom_delta_rect_t maxpool_update(nnom_layer_t *layer, nnom_delta_rect_t *in_rect)
+{
+	nnom_maxpool_layer_t *cl = (nnom_maxpool_layer_t *)layer;
+	nnom_tensor_t *in = layer->in->tensor;
+	nnom_tensor_t *out = layer->out->tensor;
+	nnom_delta_rect_t r = propagate(in_rect, cl->kernel, cl->stride, cl->pad, out);
+
+	if (rect_area(&r) == 0)
+		return r;
+
+	// always the local kernel, arm_maxpool_q7_HWC() pools in-place and destroys the cached input
+	local_maxpool_q7_HWC_region(
+		in->p_data, in->dim[1], in->dim[0], in->dim[2],
+		cl->kernel.w, cl->kernel.h, cl->pad.w, cl->pad.h, cl->stride.w, cl->stride.h,
+		out->dim[1], r.x0, r.x1, r.y0, r.y1,
+		out->p_data);
+	if (layer->actail != NULL)
+		act_region(layer->actail, out, &r);
+	return r;
+}
+
+static nnom_delta_rect_t activation_update(nnom_layer_t *layer, nnom_delta_rect_t *in_rect)
+{
+	nnom_activation_t *act = ((nnom_activation_layer_t *)layer)->act;
+
+	act->qfmt = layer->in->tensor->qfmt;
+	act_region(act, layer->in->tensor, in_rect);
+	return *in_rect;
+}
+
+static nnom_delta_rect_t batchnorm_update(nnom_layer_t *layer, nnom_delta_rect_t *in_rect)
+{
+	nnom_batchnorm_layer_t *cl = (nnom_batchnorm_layer_t *)layer;
+	nnom_tensor_t *t = layer->out->tensor;
+
+	// nothing left to do once folded into the Conv2D before
+	if (cl->folded == NULL)
+	{
+		for (int16_t y = in_rect->y0; y < in_rect->y1; y++)
+		{
+			q7_t *p = (q7_t *)t->p_data + (y * t->dim[1] + in_rect->x0) * t->dim[2];
+			local_batchnorm_q7_HWC(p, t->dim[2], in_rect->x1 - in_rect->x0,
+				cl->weights->p_value, cl->bias->p_value, cl->bias_shift, cl->output_shift, p);
+		}
+	}
+	if (layer->actail != NULL)
+		act_region(layer->actail, t, in_rect);
+	return *in_rect;
+}
+
+static bool is_activation(nnom_layer_t *layer)
+{
+	return layer->type == NNOM_ACTIVATION || layer->type == NNOM_RELU ||
+		   layer->type == NNOM_SIGMOID || layer->type == NNOM_TANH;
+}
+
+// layers which can update a region of their output from a region of their input
+static bool is_cacheable(nnom_layer_t *layer, nnom_layer_t *last)
+{
+	// single input hooked to the previous layer, single output hooked to one layer
+	if (layer->in->aux != NULL || layer->in->hook.io == NULL || layer->in->hook.io->owner != last)
+		return false;
+	if (layer->out->aux != NULL || layer->out->hook.next != NULL)
+		return false;
+	if (layer->in->tensor->num_dim != 3 || layer->out->tensor->num_dim != 3)
+		return false;
+
+	// the region update runs the q7 kernel, it must be what the full run uses
+	if (layer->type == NNOM_CONV_2D)
+		return ((nnom_conv2d_layer_t *)layer)->weights->p_value != NULL &&
+			   ((nnom_conv2d_layer_t *)layer)->int4 == NULL &&
+			   ((nnom_conv2d_layer_t *)layer)->dilation.w == 1 && ((nnom_conv2d_layer_t *)layer)->dilation.h == 1;
+	if (layer->type == NNOM_MAXPOOL)
+		return true;
+	if ((is_activation(layer) || layer->type == NNOM_BATCHNORM) && layer->out->type == LAYER_BUF_NULL)
+		return true;
+	return false;
+}
+
+// hook the inputs to the current output blocks, the same way the compiler does
+static void relink(nnom_delta_t *d)
+{
+	nnom_layer_io_t *io;
+
+	for (uint32_t i = 0; i < d->layer_num; i++)
+	{
+		nnom_layer_t *layer = d->layers[i].layer;
+
+		if (i > 0)
+			layer->in->mem = layer->in->hook.io->mem;
+		if (layer->out->type == LAYER_BUF_NULL)
+			layer->out->mem = layer->in->mem;
+
+		layer->in->tensor->p_data = layer->in->mem->blk;
+		layer->out->tensor->p_data = layer->out->mem->blk;
+		if (layer->actail != NULL)
+			layer->actail->data = layer->out->tensor->p_data;
+	}
+
+	if (d->rest != NULL)
+	{
+		for (io = d->rest->in; io != NULL; io = io->aux)
+		{
+			io->mem = io->hook.io->mem;
+			io->tensor->p_data = io->mem->blk;
+		}
+	}
+}
+
+nnom_delta_t *delta_create(nnom_model_t *m)
+{
+	nnom_delta_t *d;
+	nnom_layer_t *layer;
+	nnom_layer_t *last;
+	uint32_t num = 1;
+	uint32_t windows = 0;
+
+	if (m == NULL || m->head == NULL || m->head->type != NNOM_INPUT)
+		return NULL;
+#ifdef NNOM_USING_CHW
+	// region kernels are HWC only
+	return NULL;
+#endif
+
+	// find the cacheable stack after the input layer
+	last = m->head;
+	layer = m->head->shortcut;
+	while (layer != NULL && is_cacheable(layer, last))
+	{
+		if (layer->type == NNOM_CONV_2D || layer->type == NNOM_MAXPOOL)
+			windows++;
+		num++;
+		last = layer;
+		layer = layer->shortcut;
+	}
+	if (windows == 0)
+		return NULL;
+
+	d = nnom_mem(sizeof(nnom_delta_t) + sizeof(nnom_delta_layer_t) * num);
+	if (d == NULL)
+		return NULL;
+	d->model = m;
+	d->layers = (nnom_delta_layer_t *)((uint8_t *)d + sizeof(nnom_delta_t));
+	d->layer_num = num;
+	d->rest = layer;
+
+	// give the input and every layer that owns its output a private block
+	layer = m->head;
+	for (uint32_t i = 0; i < num; i++, layer = layer->shortcut)
+	{
+		nnom_delta_layer_t *dl = &d->layers[i];
+		nnom_layer_io_t *io = (i == 0) ? layer->in : layer->out;
+
+		dl->layer = layer;
+		if (i > 0 && layer->out->type == LAYER_BUF_NULL)
+			continue;
+
+		dl->block.size = nnom_alignto(tensor_size(io->tensor), 4);
+		dl->block.blk = nnom_mem(dl->block.size);
+		if (dl->block.blk == NULL)
+		{
+			NNOM_LOG("ERROR: No enough memory for delta cache, required %d bytes\n", dl->block.size);
+			d->layer_num = i;
+			delta_delete(d);
+			return NULL;
+		}
+		dl->block.owners = 1;
+		dl->block.state = NNOM_BUF_FILLED;
+		dl->shared = io->mem;
+		io->mem = &dl->block;
+	}
+	relink(d);
+
+	return d;
+}
+
+nnom_status_t delta_run(nnom_delta_t *d)
+{
+	nnom_model_t *m;
+	nnom_layer_t *layer;
+	nnom_delta_rect_t rect;
+	nnom_status_t result;
+	uint32_t layer_num = 1;
+	uint32_t start;
+
+	NNOM_NULL_CHECK(d);
+	m = d->model;
+
+	for (uint32_t i = 0; i < d->layer_num; i++)
+	{
+		layer = d->layers[i].layer;
+		start = nnom_us_get();
+
+		if (layer->type == NNOM_INPUT)
+		{
+			nnom_delta_rect_t full = rect_full(layer->in->tensor);
+
+			rect = input_update(d, layer);
+			if (rect_area(&rect) == rect_area(&full))
+				d->full_count++;
+		}
+		else if (layer->type == NNOM_CONV_2D)
+			rect = conv2d_update(layer, &rect);
+		else if (layer->type == NNOM_MAXPOOL)
+			rect = maxpool_update(layer, &rect);
+		else if (layer->type == NNOM_BATCHNORM)
+			rect = batchnorm_update(layer, &rect);
+		else
+			rect = activation_update(layer, &rect);
+
+		d->layers[i].dirty = rect;
+		layer->stat.time = nnom_us_get() - start;
+
+		if (m->layer_callback != NULL)
+		{
+			result = m->layer_callback(m, layer);
+			if (result != NN_SUCCESS)
+			{
+				// the caches after this layer still hold the last input's outputs
+				d->valid = false;
+				if (result != NN_MORE_TODO)
+					NNOM_LOG("Error: Callback return error code %d at #%d %s layer\n", result, layer_num, default_layer_names[layer->type]);
+				return result;
+			}
+		}
+		layer_num++;
+	}
+	d->valid = true;
+	d->run_count++;
+
+	// the rest of the model always runs in full, same as model_run_to()
+	layer = d->rest;
+	while (layer)
+	{
+		result = layer_run(layer);
+		if (result != NN_SUCCESS)
+		{
+			NNOM_LOG("Error: #%d %s layer return error code:%d\n", layer_num, default_layer_names[layer->type], result);
+			return result;
+		}
+		if (m->layer_callback != NULL)
+		{
+			result = m->layer_callback(m, layer);
+			if (result != NN_SUCCESS)
+			{
+				if (result != NN_MORE_TODO)
+					NNOM_LOG("Error: Callback return error code %d at #%d %s layer\n", result, layer_num, default_layer_names[layer->type]);
+				return result;
+			}
+		}
+		if (layer->shortcut == NULL)
+			break;
+		layer = layer->shortcut;
+		layer_num++;
+	}
+
+	return NN_SUCCESS;
+}
+
+void delta_invalidate(nnom_delta_t *d)
+{
+	if (d != NULL)
+		d->valid = false;
+}
+
+void delta_delete(nnom_delta_t *d)
+{
+	if (d == NULL)
+		return;
+
+	for (uint32_t i = 0; i < d->layer_num; i++)
+	{
+		nnom_delta_layer_t *dl = &d->layers[i];
+		nnom_layer_io_t *io = (i == 0) ? dl->layer->in : dl->layer->out;
+
+		if (dl->shared == NULL)
+			continue;
+		io->mem = dl->shared;
+		nnom_free(dl->block.blk);
+	}
+	relink(d);
+
+	nnom_free(d);
+}
@@ -0,0 +1,247 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "nnom.h"
+#include "nnom_sched.h"
+
+nnom_status_t block_mem_set(nnom_model_t *m, void *buf);
+nnom_status_t tensor_mem_set(nnom_model_t *m);
+nnom_status_t set_tailed_activation(nnom_model_t *m);
+
+// only one scheduler runs on a core at a time, the layer callback finds it here
+static nnom_sched_t *sched_running;
+
+static size_t model_mem_size(nnom_model_t *m)
+{
+	size_t size = 0;
+
+	for (uint32_t i = 0; i < NNOM_BLOCK_NUM; i++)
+		size += m->blocks[i].size;
+	return size;
+}
+
+// point the model's blocks, io tensors and tailed activations to a new buffer
+static void model_mem_move(nnom_model_t *m, void *buf)
+{
+	block_mem_set(m, buf);
+	tensor_mem_set(m);
+	set_tailed_activation(m);
+}
+
+static int32_t model_index(nnom_sched_t *s, nnom_model_t *m)
+{
+	for (uint32_t i = 0; i < s->model_num; i++)
+	{
+		if (s->models[i] == m)
+			return i;
+	}
+	return -1;
+}
+
+static bool deadline_passed(uint32_t deadline)
+{
+	return deadline != 0 && (int32_t)(nnom_ms_get() - deadline) > 0;
+}
+
+// does job a go before job b
+static bool job_before(nnom_sched_job_t *a, nnom_sched_job_t *b)
+{
+	if (a->priority != b->priority)
+		return a->priority > b->priority;
+	if (a->deadline == 0 || b->deadline == 0)
+		return b->deadline == 0 && a->deadline != 0;
+	return (int32_t)(a->deadline - b->deadline) < 0;
+}
+
+static void queue_insert(nnom_sched_t *s, nnom_sched_job_t *job)
+{
+	nnom_sched_job_t **p = &s->queue;
+
+	// first come first served among equals
+	while (*p != NULL && !job_before(job, *p))
+		p = &(*p)->next;
+	job->next = *p;
+	*p = job;
+}
+
+static nnom_status_t sched_layer_callback(nnom_model_t *m, nnom_layer_t *layer)
+{
+	nnom_sched_t *s = sched_running;
+	nnom_status_t result;
+	int32_t idx;
+
+	if (s == NULL || s->running == NULL)
+		return NN_SUCCESS;
+
+	idx = model_index(s, m);
+	if (idx >= 0 && s->model_callback[idx] != NULL)
+	{
+		result = s->model_callback[idx](m, layer);
+		if (result != NN_SUCCESS)
+			return result;
+	}
+
+	if (s->poll != NULL)
+		s->poll(s);
+
+	// give the model up at this layer boundary
+	if (s->queue != NULL && job_before(s->queue, s->running))
+		return NN_MORE_TODO;
+
+	return NN_SUCCESS;
+}
+
+nnom_sched_t *sched_create(nnom_model_t **models, uint32_t num)
+{
+	nnom_sched_t *s;
+	size_t size;
+
+	if (models == NULL || num == 0 || num > NNOM_SCHED_MODEL_MAX)
+		return NULL;
+
+	s = nnom_mem(sizeof(nnom_sched_t));
+	if (s == NULL)
+		return NULL;
+
+	for (uint32_t i = 0; i < num; i++)
+	{
+		size = model_mem_size(models[i]);
+		if (size > s->arena_size)
+			s->arena_size = size;
+	}
+
+	s->arena = nnom_mem(s->arena_size);
+	if (s->arena == NULL)
+	{
+		NNOM_LOG("ERROR: No enough memory for the shared arena, required %d bytes\n", s->arena_size);
+		nnom_free(s);
+		return NULL;
+	}
+
+	for (uint32_t i = 0; i < num; i++)
+	{
+		nnom_model_t *m = models[i];
+		void *own = m->blocks[0].blk;
+
+		model_mem_move(m, s->arena);
+		nnom_free(own);
+
+		s->models[i] = m;
+		s->model_callback[i] = m->layer_callback;
+		m->layer_callback = sched_layer_callback;
+	}
+	s->model_num = num;
+
+	NNOM_LOG("Scheduler: %d models share %d bytes of activations\n", num, s->arena_size);
+	return s;
+}
+
+nnom_status_t sched_submit(nnom_sched_t *s, nnom_sched_job_t *job)
+{
+	NNOM_NULL_CHECK(s);
+	NNOM_NULL_CHECK(job);
+	if (model_index(s, job->model) < 0)
+		return NN_ARGUMENT_ERROR;
+
+	job->preempted = 0;
+	queue_insert(s, job);
+	return NN_SUCCESS;
+}
+
+nnom_status_t sched_cancel(nnom_sched_t *s, nnom_sched_job_t *job)
+{
+	nnom_sched_job_t **p;
+
+	NNOM_NULL_CHECK(s);
+	for (p = &s->queue; *p != NULL; p = &(*p)->next)
+	{
+		if (*p == job)
+		{
+			*p = job->next;
+			job->next = NULL;
+			return NN_SUCCESS;
+		}
+	}
+	return NN_ARGUMENT_ERROR;
+}
+
+nnom_status_t sched_run(nnom_sched_t *s)
+{
+	nnom_sched_job_t *job;
+	nnom_status_t result;
+
+	NNOM_NULL_CHECK(s);
+	sched_running = s;
+
+	while (1)
+	{
+		if (s->poll != NULL)
+			s->poll(s);
+
+		job = s->queue;
+		if (job == NULL)
+			break;
+		s->queue = job->next;
+		job->next = NULL;
+
+		// too late to be of use
+		if (deadline_passed(job->deadline))
+		{
+			s->miss_count++;
+			job->done(s, job, NN_TIMEOUT);
+			continue;
+		}
+
+		s->running = job;
+		if (job->start != NULL)
+			job->start(s, job);
+		result = (job->run != NULL) ? job->run(s, job) : model_run(job->model);
+		s->running = NULL;
+
+		// a more urgent job took over, this one starts over after it
+		if (result == NN_MORE_TODO)
+		{
+			job->preempted++;
+			s->preempt_count++;
+			queue_insert(s, job);
+			continue;
+		}
+
+		s->run_count++;
+		if (deadline_passed(job->deadline))
+			s->miss_count++;
+		job->done(s, job, result);
+	}
+
+	sched_running = NULL;
+	return NN_SUCCESS;
+}
+
+void sched_delete(nnom_sched_t *s)
+{
+	if (s == NULL)
+		return;
+
+	for (uint32_t i = 0; i < s->model_num; i++)
+	{
+		nnom_model_t *m = s->models[i];
+		void *own = nnom_mem(model_mem_size(m));
+
+		// the arena stays allocated while any model still uses it
+		if (own == NULL)
+		{
+			NNOM_LOG("ERROR: No enough memory to give model %d its buffers back\n", i);
+			return;
+		}
+		model_mem_move(m, own);
+		m->layer_callback = s->model_callback[i];
+	}
+
+	nnom_free(s->arena);
+	nnom_free(s);
+}
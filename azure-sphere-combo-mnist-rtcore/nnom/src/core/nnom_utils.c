@@ -255,16 +255,12 @@ void prediction_summary(nnom_predict_t *pre)
 
 // stand alone prediction API
 // this api test one set of data, return the prediction
-nnom_status_t nnom_predict(nnom_model_t *m, uint32_t *label, float *prob)
+// top 1 of the model output after it has been run
+static void _predict_output(nnom_model_t *m, uint32_t *label, float *prob)
 {
 	int32_t max_val, max_index, sum;
 	int8_t *output;
 
-	if (!m)
-		return NN_ARGUMENT_ERROR;
-
-	model_run(m);
-
 	// get the output memory
 	output = m->tail->out->mem->blk;
 
@@ -300,7 +296,76 @@ nnom_status_t nnom_predict(nnom_model_t *m, uint32_t *label, float *prob)
 		else
 			*label = 0;
 	}
-	
+}
+
+nnom_status_t nnom_predict(nnom_model_t *m, uint32_t *label, float *prob)
+{
+	if (!m)
+		return NN_ARGUMENT_ERROR;
+
+	model_run(m);
+	_predict_output(m, label, prob);
+
+	return NN_SUCCESS;
+}
+
+// partial selection sort, k is small. ties keep the lower label first
+void nnom_topk_q7(const int8_t *output, uint32_t size, uint32_t *top_k, uint32_t k, uint32_t *confidence)
+{
+	uint32_t sum = 0;
+
+	if (k > size)
+		k = size;
+
+	for (uint32_t i = 0; i < k; i++)
+	{
+		int32_t best = -129;
+		for (uint32_t j = 0; j < size; j++)
+		{
+			bool taken = false;
+			for (uint32_t n = 0; n < i; n++)
+				taken |= (top_k[n] == j);
+			if (!taken && output[j] > best)
+			{
+				best = output[j];
+				top_k[i] = j;
+			}
+		}
+	}
+
+	// share of the best output among the positive ones, same as the prob of nnom_predict()
+	for (uint32_t j = 0; j < size; j++)
+		if (output[j] > 0)
+			sum += output[j];
+	if (k > 0 && sum != 0 && output[top_k[0]] > 0)
+		*confidence = ((uint32_t)output[top_k[0]] * 100 + sum / 2) / sum;
+	else
+		*confidence = 0;
+}
+
+nnom_status_t nnom_predict_topk(nnom_model_t *m, uint32_t *top_k, uint32_t k, uint32_t *confidence)
+{
+	if (!m || !top_k || !confidence)
+		return NN_ARGUMENT_ERROR;
+
+	model_run(m);
+	nnom_topk_q7(m->tail->out->mem->blk, tensor_size(m->tail->out->tensor), top_k, k, confidence);
+
+	return NN_SUCCESS;
+}
+
+nnom_status_t nnom_predict_delta(nnom_delta_t *d, uint32_t *label, float *prob)
+{
+	nnom_status_t result;
+
+	if (!d)
+		return NN_ARGUMENT_ERROR;
+
+	result = delta_run(d);
+	if (result != NN_SUCCESS)
+		return result;
+	_predict_output(d->model, label, prob);
+
 	return NN_SUCCESS;
 }
 
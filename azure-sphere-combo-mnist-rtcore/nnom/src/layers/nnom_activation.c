@@ -125,28 +125,16 @@ static nnom_status_t relu_run(nnom_activation_t* act)
 	return NN_SUCCESS;
 }
 
+// a table for each input format, the arm version has only Q3.4 and shifts the others to it
 static nnom_status_t tanh_run(nnom_activation_t* act)
 {
-	// arm version cannot handle int_bit > 3
-#ifdef NNOM_USING_CMSIS_NN
-	if (act->qfmt.m <= 3)
-		arm_nn_activations_direct_q7(act->data, act->size, act->qfmt.m, ARM_TANH);
-	else
-#endif
-		local_tanh_q7(act->data, act->size, act->qfmt.m);
-
+	local_tanh_q7(act->data, act->size, act->qfmt.m);
 	return NN_SUCCESS;
 }
 
 static nnom_status_t sigmoid_run( nnom_activation_t* act)
 {
-	// arm version cannot handle int_bit > 3
-#ifdef NNOM_USING_CMSIS_NN
-	if (act->qfmt.m <= 3)
-		arm_nn_activations_direct_q7(act->data, act->size, act->qfmt.m, ARM_SIGMOID);
-	else
-#endif
-		local_sigmoid_q7(act->data, act->size, act->qfmt.m);
+	local_sigmoid_q7(act->data, act->size, act->qfmt.m);
 	return NN_SUCCESS;
 }
 
@@ -41,6 +41,7 @@ nnom_layer_t *AvgPool(nnom_shape_t k, nnom_shape_t s, nnom_padding_t pad_type)
 
 nnom_status_t avgpooling_build(nnom_layer_t *layer)
 {
+	nnom_avgpool_layer_t *cl = (nnom_avgpool_layer_t *)(layer);
 	uint32_t size;
 	// avg pooling share the same output shape, stride, padding setting.
 	maxpooling_build(layer);
@@ -53,6 +54,16 @@ nnom_status_t avgpooling_build(nnom_layer_t *layer)
 	layer->comp->shape = shape(2 * size * layer->in->tensor->dim[2], 1, 1);
 	#endif
 
+	#ifndef NNOM_USING_CHW
+	// 1D, a q31 sum of each channel
+	if ((layer->in->tensor->dim[0] == 1 && cl->kernel.h == 1) || (layer->in->tensor->dim[1] == 1 && cl->kernel.w == 1))
+	{
+		size = 4 * layer->in->tensor->dim[2];
+		if (shape_size(&layer->comp->shape) < size)
+			layer->comp->shape = shape(size, 1, 1);
+	}
+	#endif
+
 	return NN_SUCCESS;
 }
 
@@ -71,6 +82,22 @@ nnom_status_t avgpool_run(nnom_layer_t *layer)
 			NULL,
 			layer->out->tensor->p_data);
 #else //end of CHW
+	// 1D along W (H = 1) or along H (W = 1), the pixels are in a row either way
+	bool along_w = layer->in->tensor->dim[0] == 1 && cl->kernel.h == 1;
+	if (along_w || (layer->in->tensor->dim[1] == 1 && cl->kernel.w == 1))
+	{
+		local_avepool_1D_HWC_q7(layer->in->tensor->p_data,
+				layer->in->tensor->dim[0] * layer->in->tensor->dim[1], layer->in->tensor->dim[2],
+				along_w ? cl->kernel.w : cl->kernel.h,
+				along_w ? cl->pad.w : cl->pad.h,
+				along_w ? cl->stride.w : cl->stride.h,
+				layer->out->tensor->dim[0] * layer->out->tensor->dim[1],
+				cl->output_shift,
+				layer->comp->mem->blk,
+				layer->out->tensor->p_data);
+		return NN_SUCCESS;
+	}
+
 	#ifdef NNOM_USING_CMSIS_NN
 	// 2D, square
 	if (layer->in->tensor->dim[1] == layer->in->tensor->dim[0] &&
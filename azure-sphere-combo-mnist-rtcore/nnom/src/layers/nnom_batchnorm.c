@@ -0,0 +1,239 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "nnom.h"
+#include "nnom_local.h"
+#include "nnom_layers.h"
+
+nnom_status_t batchnorm_build(nnom_layer_t *layer);
+nnom_status_t batchnorm_run(nnom_layer_t *layer);
+
+// the folded weights are allocated in build
+static nnom_status_t batchnorm_free(nnom_layer_t *layer)
+{
+	nnom_batchnorm_layer_t *cl = (nnom_batchnorm_layer_t *)layer;
+
+	if (cl->fold_w.p_value != NULL)
+		nnom_free((void *)cl->fold_w.p_value);
+	return NN_SUCCESS;
+}
+
+nnom_layer_t *BatchNorm(const nnom_weight_t *w, const nnom_bias_t *b)
+{
+	nnom_batchnorm_layer_t *layer;
+	nnom_layer_io_t *in, *out;
+
+	// apply a block memory for all the sub handles.
+	size_t mem_size = sizeof(nnom_batchnorm_layer_t) + sizeof(nnom_layer_io_t) * 2;
+	layer = nnom_mem(mem_size);
+	if (layer == NULL)
+		return NULL;
+
+	// distribut the memory to sub handles.
+	in = (void *)((uint8_t*)layer + sizeof(nnom_batchnorm_layer_t));
+	out = (void *)((uint8_t*)in + sizeof(nnom_layer_io_t));
+
+	// set type in layer parent
+	layer->super.type = NNOM_BATCHNORM;
+	// set buf state, scaled in-place
+	in->type = LAYER_BUF_TEMP;
+	out->type = LAYER_BUF_NULL;
+	// put in & out on the layer.
+	layer->super.in = io_init(layer, in);
+	layer->super.out = io_init(layer, out);
+	// set run, outshape and free methods
+	layer->super.run = batchnorm_run;
+	layer->super.build = batchnorm_build;
+	layer->super.free = batchnorm_free;
+
+	// set parameters
+	layer->weights = w;
+	layer->bias = b;
+	layer->output_shift = w->shift;
+	layer->bias_shift = b->shift;
+
+	return (nnom_layer_t *)layer;
+}
+
+// the output of a Conv2D/Dense that its i-th weight belongs to
+static uint32_t weight_output(nnom_layer_t *layer, uint32_t i, uint32_t num, uint32_t out_ch)
+{
+	uint32_t dim_vec = num / out_ch;
+
+	if (layer->type == NNOM_CONV_2D)
+	{
+#ifdef NNOM_USING_CHW
+		return i % out_ch;
+#else
+		return i / dim_vec;
+#endif
+	}
+#if DENSE_WEIGHT_OPT
+	// rows in groups of 4, see local_fully_connected_q7_opt(). the rows left over are in order
+	uint32_t row = i / (4 * dim_vec) * 4;
+	uint32_t j = i % (4 * dim_vec);
+
+	if (row + 4 > out_ch)
+		return row + j / dim_vec;
+	if (j < (dim_vec & ~0x3) * 4)
+		return row + ((j >> 2) & 0x1) * 2 + (j & 0x1);
+	return row + (j & 0x3);
+#else
+	return i / dim_vec;
+#endif
+}
+
+// fold y = (x * w + b) * scale + offset into w' = w * scale, b' = b * scale + offset.
+// w * scale is scaled back to q7 with one more right shift k, taken from the output shift.
+static bool batchnorm_fold(nnom_batchnorm_layer_t *cl, nnom_layer_t *prev)
+{
+	const q7_t *scale = cl->weights->p_value;
+	const q7_t *offset = cl->bias->p_value;
+	const q7_t *w, *b;
+	int8_t *p_bshift, *p_oshift;
+	uint32_t num, out_ch;
+	int32_t max = 0;
+	int32_t k = 0, bshift = 0, oshift;
+	q7_t *new_w, *new_b;
+
+	// one kernel, and no activation in between
+	if (prev->actail != NULL || prev->out->aux != NULL || prev->out->hook.next != NULL)
+		return false;
+	if (prev->type == NNOM_CONV_2D)
+	{
+		nnom_conv2d_layer_t *conv = (nnom_conv2d_layer_t *)prev;
+
+		if (conv->weights->p_value == NULL || conv->winograd != NULL || conv->sparse != NULL || conv->int4 != NULL)
+			return false;
+		w = conv->weights->p_value;
+		b = conv->bias->p_value;
+		p_bshift = &conv->bias_shift;
+		p_oshift = &conv->output_shift;
+		out_ch = conv->filter_mult;
+		num = conv->kernel.w * conv->kernel.h * prev->in->tensor->dim[2] * out_ch;
+	}
+	else if (prev->type == NNOM_DENSE)
+	{
+		nnom_dense_layer_t *dense = (nnom_dense_layer_t *)prev;
+
+		if (dense->weights->p_value == NULL || dense->sparse != NULL || dense->int4 != NULL)
+			return false;
+		w = dense->weights->p_value;
+		b = dense->bias->p_value;
+		p_bshift = &dense->bias_shift;
+		p_oshift = &dense->output_shift;
+		out_ch = dense->output_unit;
+		num = tensor_size(prev->in->tensor) * out_ch;
+	}
+	else
+		return false;
+	if (num + out_ch > NNOM_BATCHNORM_FOLD_MAX)
+		return false;
+
+	// the shift that brings the largest product back to q7
+	for (uint32_t i = 0; i < num; i++)
+	{
+		int32_t p = w[i] * scale[weight_output(prev, i, num, out_ch)];
+		max = p > max ? p : (-p > max ? -p : max);
+	}
+	while ((max >> k) > 127)
+		k++;
+	oshift = *p_oshift + cl->output_shift - k;
+	if (oshift < 1)
+		return false;
+
+	new_w = nnom_mem(num + out_ch);
+	if (new_w == NULL)
+		return false;
+	new_b = new_w + num;
+
+	for (uint32_t i = 0; i < num; i++)
+	{
+		int32_t p = w[i] * scale[weight_output(prev, i, num, out_ch)];
+		if (k > 0)
+			p = (p + (0x1 << (k - 1))) >> k;
+		new_w[i] = (q7_t)__NNOM_SSAT(p, 8);
+	}
+
+	// both biases in the unit of the new accumulator, then the smallest shift that fits them in q7
+	max = 0;
+	for (uint32_t c = 0; c < out_ch; c++)
+	{
+		int64_t sum = ((int64_t)b[c] * scale[c] << *p_bshift) + ((int64_t)offset[c] << (cl->bias_shift + *p_oshift));
+		int32_t bias = (int32_t)(sum >> k);
+		max = bias > max ? bias : (-bias > max ? -bias : max);
+	}
+	while ((max >> bshift) > 127)
+		bshift++;
+	for (uint32_t c = 0; c < out_ch; c++)
+	{
+		int64_t sum = ((int64_t)b[c] * scale[c] << *p_bshift) + ((int64_t)offset[c] << (cl->bias_shift + *p_oshift));
+		new_b[c] = (q7_t)__NNOM_SSAT((int32_t)(sum >> (k + bshift)), 8);
+	}
+
+	cl->fold_w.p_value = new_w;
+	cl->fold_w.shift = oshift;
+	cl->fold_b.p_value = new_b;
+	cl->fold_b.shift = bshift;
+	*p_oshift = oshift;
+	*p_bshift = bshift;
+	if (prev->type == NNOM_CONV_2D)
+	{
+		((nnom_conv2d_layer_t *)prev)->weights = &cl->fold_w;
+		((nnom_conv2d_layer_t *)prev)->bias = &cl->fold_b;
+	}
+	else
+	{
+		((nnom_dense_layer_t *)prev)->weights = &cl->fold_w;
+		((nnom_dense_layer_t *)prev)->bias = &cl->fold_b;
+	}
+	cl->folded = prev;
+	return true;
+}
+
+nnom_status_t batchnorm_build(nnom_layer_t *layer)
+{
+	nnom_batchnorm_layer_t *cl = (nnom_batchnorm_layer_t *)layer;
+
+	// get the tensor from last layer's output, the output has the same shape
+	layer->in->tensor = layer->in->hook.io->tensor;
+	layer->out->tensor = new_tensor(NULL, layer->in->tensor->num_dim);
+	tensor_cpy_attributes(layer->out->tensor, layer->in->tensor);
+
+	// cost: one multiply for each value, or none once folded
+	if (cl->folded == NULL && !batchnorm_fold(cl, layer->in->hook.io->owner))
+	{
+		layer->stat.macc = tensor_size(layer->out->tensor);
+		// other layers read the same input, keep it as it is
+		if (layer->in->hook.io->hook.next != NULL)
+			layer->out->type = LAYER_BUF_TEMP;
+	}
+	return NN_SUCCESS;
+}
+
+nnom_status_t batchnorm_run(nnom_layer_t *layer)
+{
+	nnom_batchnorm_layer_t *cl = (nnom_batchnorm_layer_t *)layer;
+	nnom_tensor_t *t = layer->out->tensor;
+	uint32_t ch = t->dim[t->num_dim - 1];
+
+	// the layer before does it all
+	if (cl->folded != NULL)
+		return NN_SUCCESS;
+
+#ifdef NNOM_USING_CHW
+	local_batchnorm_q7_CHW(
+#else
+	local_batchnorm_q7_HWC(
+#endif
+		layer->in->tensor->p_data, ch, tensor_size(t) / ch,
+		cl->weights->p_value, cl->bias->p_value,
+		cl->bias_shift, cl->output_shift,
+		t->p_data);
+	return NN_SUCCESS;
+}
@@ -66,6 +66,8 @@ nnom_layer_t *Conv2D(uint32_t filters, nnom_shape_t k, nnom_shape_t s, nnom_padd
 	// get the private parameters
 	layer->kernel = k;
 	layer->stride = s;
+	layer->dilation = dilation(1, 1);
+	layer->upsample = shape(1, 1, 1);
 	layer->bias = b;
 	layer->weights = w;
 	layer->output_shift = w->shift;
@@ -84,11 +86,103 @@ nnom_layer_t *Conv2D(uint32_t filters, nnom_shape_t k, nnom_shape_t s, nnom_padd
 	return (nnom_layer_t *)layer;
 }
 
+nnom_layer_t *conv2d_winograd(nnom_layer_t *layer, const nnom_weight_t *w)
+{
+	if (layer != NULL && layer->type == NNOM_CONV_2D)
+		((nnom_conv2d_layer_t *)layer)->winograd = w;
+	return layer;
+}
+
+nnom_layer_t *conv2d_dilation(nnom_layer_t *layer, nnom_shape_t d)
+{
+	nnom_conv2d_layer_t *cl = (nnom_conv2d_layer_t *)layer;
+
+	if (layer != NULL && (layer->type == NNOM_CONV_2D || layer->type == NNOM_DW_CONV_2D))
+	{
+		cl->dilation = d;
+		// padding of the dilated kernel
+		if (cl->padding_type == PADDING_SAME)
+		{
+			cl->pad.w = (cl->kernel.w - 1) * d.w / 2;
+			cl->pad.h = (cl->kernel.h - 1) * d.h / 2;
+		}
+	}
+	return layer;
+}
+
+nnom_layer_t *conv2d_sparse(nnom_layer_t *layer, const nnom_sparse_weight_t *w)
+{
+	if (layer != NULL && layer->type == NNOM_CONV_2D)
+		((nnom_conv2d_layer_t *)layer)->sparse = w;
+	return layer;
+}
+
+nnom_layer_t *conv2d_int4(nnom_layer_t *layer, const nnom_int4_weight_t *w)
+{
+	if (layer != NULL && layer->type == NNOM_CONV_2D)
+		((nnom_conv2d_layer_t *)layer)->int4 = w;
+	return layer;
+}
+
+// the Conv2D after a ZeroPadding or UpSample, if it can read that layer's input in its place.
+// It must be the only reader, and the up sampling is only known by the q7 gather
+nnom_layer_t *conv2d_fuse_input(nnom_layer_t *layer)
+{
+#if NNOM_FUSE_CONV_INPUT && !defined(NNOM_USING_CHW)
+	nnom_conv2d_layer_t *cl;
 
+	if (layer->actail != NULL || layer->out->aux != NULL || layer->out->hook.next != NULL || layer->out->hook.io == NULL)
+		return NULL;
+	if (layer->out->hook.io->owner->type != NNOM_CONV_2D || layer->out->hook.io->owner->in->aux != NULL)
+		return NULL;
+	cl = (nnom_conv2d_layer_t *)layer->out->hook.io->owner;
+	if (layer->type == NNOM_UPSAMPLE && (cl->weights->p_value == NULL || cl->sparse != NULL || cl->int4 != NULL))
+		return NULL;
+	return (nnom_layer_t *)cl;
+#else
+	return NULL;
+#endif
+}
+
+// 1D along W (H = 1) or along H (W = 1), the pixels are in a row either way.
+// Not when a fused ZeroPadding or UpSample makes the output taller (or wider) than the input
+static bool conv2d_1d(nnom_layer_t *layer, bool *along_w)
+{
+	nnom_conv2d_layer_t *cl = (nnom_conv2d_layer_t *)layer;
+
+	if (cl->upsample.w > 1 || cl->upsample.h > 1)
+		return false;
+	*along_w = layer->in->tensor->dim[0] == 1 && cl->kernel.h == 1 && layer->out->tensor->dim[0] == 1 && cl->pad.h == 0;
+	return *along_w || (layer->in->tensor->dim[1] == 1 && cl->kernel.w == 1 && layer->out->tensor->dim[1] == 1 && cl->pad.w == 0);
+}
+
+// the padding of a fused ZeroPadding, or NULL
+static nnom_border_t *conv2d_fused_border(nnom_layer_t *layer)
+{
+	nnom_layer_t *prev = layer->in->hook.io->owner;
+
+	if (prev->type == NNOM_ZERO_PADDING && ((nnom_zero_padding_layer_t *)prev)->fused == layer)
+		return &((nnom_zero_padding_layer_t *)prev)->pad;
+	return NULL;
+}
+
+// run by local_convolve_HWC_q7_dilated(), its gather bounds-checks every tap against the input.
+// The CMSIS kernels only check the borders of a padding that fits the kernel, the middle region is
+// read as it is. A fused ZeroPadding can leave the input shorter than that, so it is gathered too
+static bool conv2d_gather(nnom_layer_t *layer)
+{
+	nnom_conv2d_layer_t *cl = (nnom_conv2d_layer_t *)layer;
+
+	return cl->dilation.w > 1 || cl->dilation.h > 1 || cl->upsample.w > 1 || cl->upsample.h > 1 ||
+		conv2d_fused_border(layer) != NULL;
+}
 
 nnom_status_t conv2d_build(nnom_layer_t *layer)
 {
 	nnom_conv2d_layer_t *cl = (nnom_conv2d_layer_t *)layer;
+	nnom_layer_t *prev = layer->in->hook.io->owner;
+	nnom_border_t *border;
+	bool along_w;
 
 	// get the tensor from last layer's output
 	layer->in->tensor = layer->in->hook.io->tensor;
@@ -107,16 +201,86 @@ nnom_status_t conv2d_build(nnom_layer_t *layer)
 	}
 	else
 	{
-		layer->out->tensor->dim[0] = NN_CEILIF(layer->in->tensor->dim[0] - cl->kernel.h + 1, cl->stride.h);
-		layer->out->tensor->dim[1] = NN_CEILIF(layer->in->tensor->dim[1] - cl->kernel.w + 1, cl->stride.w);
+		// the dilated kernel spans (k - 1) * d + 1 pixels
+		layer->out->tensor->dim[0] = NN_CEILIF(layer->in->tensor->dim[0] - (cl->kernel.h - 1) * cl->dilation.h, cl->stride.h);
+		layer->out->tensor->dim[1] = NN_CEILIF(layer->in->tensor->dim[1] - (cl->kernel.w - 1) * cl->dilation.w, cl->stride.w);
 		layer->out->tensor->dim[2] = cl->filter_mult;
 	}
 
+	// a fused ZeroPadding or UpSample did not make its output, read its input instead.
+	// The left/top borders are added to our padding, the others are the pixels out of the input
+	border = conv2d_fused_border(layer);
+	if (border != NULL)
+	{
+		layer->in->tensor = prev->in->tensor;
+		cl->pad.w = (cl->padding_type == PADDING_SAME ? (cl->kernel.w - 1) * cl->dilation.w / 2 : 0) + border->left;
+		cl->pad.h = (cl->padding_type == PADDING_SAME ? (cl->kernel.h - 1) * cl->dilation.h / 2 : 0) + border->top;
+	}
+	else if (prev->type == NNOM_UPSAMPLE && ((nnom_upsample_layer_t *)prev)->fused == layer)
+	{
+		layer->in->tensor = prev->in->tensor;
+		cl->upsample = ((nnom_upsample_layer_t *)prev)->kernel;
+	}
+
 	// bufferA size: (1D shape)
 	// 2*ch_im_in*dim_kernel*dim_kernel
 	layer->comp->shape = shape(2 * 2 * layer->in->tensor->dim[2] * cl->kernel.w * cl->kernel.h, 1, 1);
+
 	// computational cost: K x K x Cin x Hour x Wout x Cout
 	layer->stat.macc = cl->kernel.w * cl->kernel.h * layer->in->tensor->dim[2] * tensor_size(layer->out->tensor);
+
+	// gathered or 1D, two patches widened to q15 and one gathered in q7
+	if (conv2d_gather(layer) || conv2d_1d(layer, &along_w))
+	{
+		cl->winograd = NULL;
+		layer->comp->shape = shape(5 * layer->in->tensor->dim[2] * cl->kernel.w * cl->kernel.h, 1, 1);
+	}
+
+	// 4-bit weights, the patch is widened to q15 in padded columns of 8
+	if (cl->int4 != NULL)
+	{
+#ifdef NNOM_USING_CHW
+		cl->int4 = NULL;
+#else
+		cl->sparse = NULL;
+		cl->winograd = NULL;
+		layer->comp->shape = shape(5 * nnom_alignto(layer->in->tensor->dim[2] * cl->kernel.w * cl->kernel.h, 8), 1, 1);
+#endif
+	}
+
+	// keep the sparse weights only if they skip enough, or if there is no dense kernel
+	if (cl->sparse != NULL)
+	{
+#ifdef NNOM_USING_CHW
+		cl->sparse = NULL;
+#else
+		size_t len = nnom_alignto(layer->in->tensor->dim[2] * cl->kernel.w * cl->kernel.h, 4);
+		size_t nonzero = cl->sparse->row_ptr[cl->filter_mult] * 4;
+
+		if (cl->weights->p_value != NULL && nonzero * 100 > len * cl->filter_mult * NNOM_SPARSE_MAX_DENSITY)
+			cl->sparse = NULL;
+		else
+		{
+			cl->winograd = NULL;
+			layer->comp->shape = shape(5 * len, 1, 1);
+			layer->stat.macc = nonzero * layer->out->tensor->dim[0] * layer->out->tensor->dim[1];
+		}
+#endif
+	}
+
+	// Winograd pays off once there are enough channels to spread the transforms over
+	if (cl->winograd != NULL)
+	{
+#ifdef NNOM_USING_CHW
+		cl->winograd = NULL;
+#else
+		if (cl->kernel.w != 3 || cl->kernel.h != 3 || cl->stride.w != 1 || cl->stride.h != 1 ||
+			layer->in->tensor->dim[2] < NNOM_WINOGRAD_MIN_CH || cl->filter_mult < NNOM_WINOGRAD_MIN_CH)
+			cl->winograd = NULL;
+		else
+			layer->comp->shape = shape(65 * layer->in->tensor->dim[2], 1, 1);
+#endif
+	}
 	return NN_SUCCESS;
 }
 
@@ -124,6 +288,7 @@ nnom_status_t conv2d_build(nnom_layer_t *layer)
 nnom_status_t conv2d_run(nnom_layer_t *layer)
 {
 	nnom_conv2d_layer_t *cl = (nnom_conv2d_layer_t *)layer;
+	bool along_w;
 
 #ifdef NNOM_USING_CHW
 	// CHW format
@@ -132,16 +297,87 @@ nnom_status_t conv2d_run(nnom_layer_t *layer)
 				layer->in->tensor->dim[1], layer->in->tensor->dim[0], layer->in->tensor->dim[2],
 				cl->weights->p_value, layer->out->tensor->dim[2],
 				cl->kernel.w, cl->kernel.h, cl->pad.w, cl->pad.h, cl->stride.w, cl->stride.h,
+				cl->dilation.w, cl->dilation.h,
 				cl->bias->p_value, cl->bias_shift, cl->output_shift,
 				layer->out->tensor->p_data,
 				layer->out->tensor->dim[1], layer->out->tensor->dim[0], (q15_t *)(layer->comp->mem->blk), NULL);
 	return NN_SUCCESS;
 #else
 	// HWC format
+	if (cl->int4 != NULL)
+	{
+		local_convolve_HWC_q7_int4(
+				layer->in->tensor->p_data,
+				layer->in->tensor->dim[1], layer->in->tensor->dim[0], layer->in->tensor->dim[2],
+				cl->int4->p_value, layer->out->tensor->dim[2],
+				cl->kernel.w, cl->kernel.h, cl->pad.w, cl->pad.h, cl->stride.w, cl->stride.h,
+				cl->dilation.w, cl->dilation.h,
+				cl->bias->p_value, cl->bias_shift, cl->output_shift, cl->int4->bias_shift, cl->int4->output_shift,
+				layer->out->tensor->p_data,
+				layer->out->tensor->dim[1], layer->out->tensor->dim[0], (q15_t *)(layer->comp->mem->blk));
+		return NN_SUCCESS;
+	}
+	if (cl->sparse != NULL)
+	{
+		local_convolve_HWC_q7_sparse(
+				layer->in->tensor->p_data,
+				layer->in->tensor->dim[1], layer->in->tensor->dim[0], layer->in->tensor->dim[2],
+				cl->sparse->p_value, cl->sparse->block_idx, cl->sparse->row_ptr, layer->out->tensor->dim[2],
+				cl->kernel.w, cl->kernel.h, cl->pad.w, cl->pad.h, cl->stride.w, cl->stride.h,
+				cl->dilation.w, cl->dilation.h,
+				cl->bias->p_value, cl->bias_shift, cl->output_shift,
+				layer->out->tensor->p_data,
+				layer->out->tensor->dim[1], layer->out->tensor->dim[0], (q15_t *)(layer->comp->mem->blk));
+		return NN_SUCCESS;
+	}
+	if (cl->winograd != NULL)
+	{
+		local_convolve_HWC_q7_winograd(
+				layer->in->tensor->p_data,
+				layer->in->tensor->dim[1], layer->in->tensor->dim[0], layer->in->tensor->dim[2],
+				cl->winograd->p_value, layer->out->tensor->dim[2],
+				cl->pad.w, cl->pad.h,
+				cl->bias->p_value, cl->bias_shift, cl->output_shift,
+				layer->out->tensor->p_data,
+				layer->out->tensor->dim[1], layer->out->tensor->dim[0], (q15_t *)(layer->comp->mem->blk));
+		return NN_SUCCESS;
+	}
+	if (conv2d_1d(layer, &along_w))
+	{
+		local_convolve_1D_HWC_q7(
+				layer->in->tensor->p_data,
+				layer->in->tensor->dim[0] * layer->in->tensor->dim[1], layer->in->tensor->dim[2],
+				cl->weights->p_value, layer->out->tensor->dim[2],
+				along_w ? cl->kernel.w : cl->kernel.h, along_w ? cl->pad.w : cl->pad.h,
+				along_w ? cl->stride.w : cl->stride.h, along_w ? cl->dilation.w : cl->dilation.h,
+				cl->bias->p_value, cl->bias_shift, cl->output_shift,
+				layer->out->tensor->p_data,
+				layer->out->tensor->dim[0] * layer->out->tensor->dim[1], (q15_t *)(layer->comp->mem->blk));
+		return NN_SUCCESS;
+	}
+	if (conv2d_gather(layer))
+	{
+		local_convolve_HWC_q7_dilated(
+				layer->in->tensor->p_data,
+				layer->in->tensor->dim[1], layer->in->tensor->dim[0], layer->in->tensor->dim[2],
+				cl->weights->p_value, layer->out->tensor->dim[2],
+				cl->kernel.w, cl->kernel.h, cl->pad.w, cl->pad.h, cl->stride.w, cl->stride.h,
+				cl->dilation.w, cl->dilation.h, cl->upsample.w, cl->upsample.h,
+				cl->bias->p_value, cl->bias_shift, cl->output_shift,
+				layer->out->tensor->p_data,
+				layer->out->tensor->dim[1], layer->out->tensor->dim[0], (q15_t *)(layer->comp->mem->blk));
+		return NN_SUCCESS;
+	}
+
 	#ifdef NNOM_USING_CMSIS_NN
+	// the square kernels only take the x of the shapes
+	bool square = layer->in->tensor->dim[0] == layer->in->tensor->dim[1] &&
+		layer->out->tensor->dim[0] == layer->out->tensor->dim[1] &&
+		cl->kernel.w == cl->kernel.h && cl->pad.w == cl->pad.h && cl->stride.w == cl->stride.h;
+
 	//RGB
 	// ch_im_in = 3, w = h
-	if (layer->in->tensor->dim[2] == 3 && layer->in->tensor->dim[0] == layer->in->tensor->dim[1])
+	if (layer->in->tensor->dim[2] == 3 && square)
 		return (nnom_status_t)arm_convolve_HWC_q7_RGB(
 			layer->in->tensor->p_data, layer->in->tensor->dim[1], layer->in->tensor->dim[2],
 			cl->weights->p_value,
@@ -157,8 +393,10 @@ nnom_status_t conv2d_run(nnom_layer_t *layer)
 	if (layer->in->tensor->dim[2] % 4 == 0 &&
 		layer->out->tensor->dim[2] % 2 == 0)
 	{
-		// 1x1 fast
-		if (cl->kernel.w == 1 && cl->kernel.h == 1)
+		// 1x1 fast, stride 1 and no padding only, the output is the input size
+		if (cl->kernel.w == 1 && cl->kernel.h == 1 && cl->stride.w == 1 && cl->stride.h == 1 &&
+			cl->pad.w == 0 && cl->pad.h == 0 &&
+			layer->out->tensor->dim[0] == layer->in->tensor->dim[0] && layer->out->tensor->dim[1] == layer->in->tensor->dim[1])
 			return (nnom_status_t)arm_convolve_1x1_HWC_q7_fast_nonsquare(
 				layer->in->tensor->p_data,
 				layer->in->tensor->dim[1], layer->in->tensor->dim[0], layer->in->tensor->dim[2],
@@ -169,7 +407,7 @@ nnom_status_t conv2d_run(nnom_layer_t *layer)
 				cl->output_shift, layer->out->tensor->p_data, layer->out->tensor->dim[1], layer->out->tensor->dim[0],
 				(q15_t *)(layer->comp->mem->blk), NULL);
 		// opt square shape
-		if (layer->in->tensor->dim[0] == layer->in->tensor->dim[1])
+		if (square)
 			return (nnom_status_t)arm_convolve_HWC_q7_fast(
 				layer->in->tensor->p_data, layer->in->tensor->dim[1], layer->in->tensor->dim[2],
 				cl->weights->p_value,
@@ -192,7 +430,7 @@ nnom_status_t conv2d_run(nnom_layer_t *layer)
 	else
 	{
 		// none opt square shape
-		if (layer->in->tensor->dim[0] == layer->in->tensor->dim[1])
+		if (square)
 			return (nnom_status_t)arm_convolve_HWC_q7_basic(
 				layer->in->tensor->p_data, layer->in->tensor->dim[1], layer->in->tensor->dim[2],
 				cl->weights->p_value,
@@ -67,6 +67,20 @@ nnom_layer_t *Dense(size_t output_unit, const nnom_weight_t *w, const nnom_bias_
 	return (nnom_layer_t *)layer;
 }
 
+nnom_layer_t *dense_sparse(nnom_layer_t *layer, const nnom_sparse_weight_t *w)
+{
+	if (layer != NULL && layer->type == NNOM_DENSE)
+		((nnom_dense_layer_t *)layer)->sparse = w;
+	return layer;
+}
+
+nnom_layer_t *dense_int4(nnom_layer_t *layer, const nnom_int4_weight_t *w)
+{
+	if (layer != NULL && layer->type == NNOM_DENSE)
+		((nnom_dense_layer_t *)layer)->int4 = w;
+	return layer;
+}
+
 nnom_status_t dense_build(nnom_layer_t *layer)
 {
 	nnom_dense_layer_t *cl = (nnom_dense_layer_t *)layer;
@@ -86,6 +100,29 @@ nnom_status_t dense_build(nnom_layer_t *layer)
 
 	// computational cost: In * out
 	layer->stat.macc = tensor_size(layer->in->tensor) * tensor_size(layer->out->tensor);
+
+	// 4-bit weights, q15 copy of the input padded to 8
+	if (cl->int4 != NULL)
+	{
+		cl->sparse = NULL;
+		layer->comp->shape = shape(nnom_alignto(tensor_size(layer->in->tensor), 8) * 2, 1, 1);
+	}
+
+	// keep the sparse weights only if they skip enough, or if there is no dense kernel
+	if (cl->sparse != NULL)
+	{
+		size_t len = nnom_alignto(tensor_size(layer->in->tensor), 4);
+		size_t nonzero = cl->sparse->row_ptr[cl->output_unit] * 4;
+
+		if (cl->weights->p_value != NULL && nonzero * 100 > len * cl->output_unit * NNOM_SPARSE_MAX_DENSITY)
+			cl->sparse = NULL;
+		else
+		{
+			// q15 copy of the input padded to 4
+			layer->comp->shape = shape(len * 2, 1, 1);
+			layer->stat.macc = nonzero;
+		}
+	}
 	return NN_SUCCESS;
 }
 
@@ -94,6 +131,28 @@ nnom_status_t dense_run(nnom_layer_t *layer)
 	nnom_status_t result = NN_SUCCESS;
 	nnom_dense_layer_t *cl = (nnom_dense_layer_t *)(layer);
 
+	if (cl->int4 != NULL)
+	{
+		local_fully_connected_q7_int4(
+			layer->in->tensor->p_data, cl->int4->p_value,
+			tensor_size(layer->in->tensor), layer->out->tensor->dim[0],
+			cl->bias_shift, cl->output_shift, cl->int4->bias_shift, cl->int4->output_shift,
+			cl->bias->p_value,
+			layer->out->tensor->p_data, (q15_t *)(layer->comp->mem->blk));
+		return NN_SUCCESS;
+	}
+	if (cl->sparse != NULL)
+	{
+		local_fully_connected_q7_sparse(
+			layer->in->tensor->p_data,
+			cl->sparse->p_value, cl->sparse->block_idx, cl->sparse->row_ptr,
+			tensor_size(layer->in->tensor), layer->out->tensor->dim[0],
+			cl->bias_shift, cl->output_shift,
+			cl->bias->p_value,
+			layer->out->tensor->p_data, (q15_t *)(layer->comp->mem->blk));
+		return NN_SUCCESS;
+	}
+
 #if !(DENSE_WEIGHT_OPT)
 	#ifdef NNOM_USING_CMSIS_NN
 		result = (nnom_status_t)arm_fully_connected_q7(
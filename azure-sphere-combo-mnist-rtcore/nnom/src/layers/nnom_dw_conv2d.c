@@ -61,8 +61,9 @@ nnom_status_t dw_conv2d_build(nnom_layer_t *layer)
 	}
 	else
 	{
-		layer->out->tensor->dim[0] = NN_CEILIF(layer->in->tensor->dim[0] - cl->kernel.h + 1, cl->stride.h);
-		layer->out->tensor->dim[1] = NN_CEILIF(layer->in->tensor->dim[1] - cl->kernel.w + 1, cl->stride.w);
+		// the dilated kernel spans (k - 1) * d + 1 pixels
+		layer->out->tensor->dim[0] = NN_CEILIF(layer->in->tensor->dim[0] - (cl->kernel.h - 1) * cl->dilation.h, cl->stride.h);
+		layer->out->tensor->dim[1] = NN_CEILIF(layer->in->tensor->dim[1] - (cl->kernel.w - 1) * cl->dilation.w, cl->stride.w);
 		layer->out->tensor->dim[2] = layer->in->tensor->dim[2] * cl->filter_mult;
 	}
 
@@ -82,7 +83,37 @@ nnom_status_t dw_conv2d_run(nnom_layer_t *layer)
 
 #ifdef NNOM_USING_CHW
 	local_depthwise_separable_conv_CHW_q7_nonsquare(
-#else	
+		layer->in->tensor->p_data,
+		layer->in->tensor->dim[1], layer->in->tensor->dim[0], layer->in->tensor->dim[2],
+		cl->weights->p_value,
+		layer->in->tensor->dim[2],
+		cl->kernel.w, cl->kernel.h,
+		cl->pad.w, cl->pad.h,
+		cl->stride.w, cl->stride.h,
+		cl->dilation.w, cl->dilation.h,
+		cl->bias->p_value,
+		cl->bias_shift, cl->output_shift,
+		layer->out->tensor->p_data,
+		layer->out->tensor->dim[1], layer->out->tensor->dim[0], (q15_t *)(layer->comp->mem->blk), NULL);
+#else
+	// dilated, bufferA is large enough for a q31 sum of each channel
+	if (cl->dilation.w > 1 || cl->dilation.h > 1)
+	{
+		local_depthwise_separable_conv_HWC_q7_dilated(
+			layer->in->tensor->p_data,
+			layer->in->tensor->dim[1], layer->in->tensor->dim[0], layer->in->tensor->dim[2],
+			cl->weights->p_value,
+			cl->kernel.w, cl->kernel.h,
+			cl->pad.w, cl->pad.h,
+			cl->stride.w, cl->stride.h,
+			cl->dilation.w, cl->dilation.h,
+			cl->bias->p_value,
+			cl->bias_shift, cl->output_shift,
+			layer->out->tensor->p_data,
+			layer->out->tensor->dim[1], layer->out->tensor->dim[0], (q31_t *)(layer->comp->mem->blk));
+		return NN_SUCCESS;
+	}
+
 	#ifdef NNOM_USING_CMSIS_NN
 		// CMSIS-NN only support 1 mulplipier in depthwise conv
 		if (cl->filter_mult != 1 || layer->in->tensor->dim[2] % 2 != 0 || layer->out->tensor->dim[2] % 2)
@@ -91,7 +122,6 @@ nnom_status_t dw_conv2d_run(nnom_layer_t *layer)
 	#else
 		local_depthwise_separable_conv_HWC_q7_nonsquare(
 	#endif
-#endif
 		layer->in->tensor->p_data,
 		layer->in->tensor->dim[1], layer->in->tensor->dim[0], layer->in->tensor->dim[2],
 		cl->weights->p_value,
@@ -103,6 +133,7 @@ nnom_status_t dw_conv2d_run(nnom_layer_t *layer)
 		cl->bias_shift, cl->output_shift,
 		layer->out->tensor->p_data,
 		layer->out->tensor->dim[1], layer->out->tensor->dim[0], (q15_t *)(layer->comp->mem->blk), NULL);
+#endif
 
 	return result;
 }
@@ -31,6 +31,7 @@ nnom_layer_t *GlobalMaxPool(void)
 	if (layer != NULL)
 	{
 		layer->type = NNOM_GLOBAL_MAXPOOL;
+		layer->run = global_maxpool_run;
 		layer->build = global_pooling_build;
 	}
 
@@ -47,7 +48,7 @@ nnom_layer_t *GlobalAvgPool(void)
 	if (layer != NULL)
 	{
 		layer->type = NNOM_GLOBAL_AVGPOOL;
-		layer->run = avgpool_run; // global and basic pooling share the same runner
+		layer->run = global_avgpool_run;
 		layer->build = global_pooling_build;
 	}
 
@@ -64,7 +65,7 @@ nnom_layer_t *GlobalSumPool(void)
 	if (layer != NULL)
 	{
 		layer->type = NNOM_GLOBAL_SUMPOOL;
-		layer->run = sumpool_run; // global and basic pooling share the same runner
+		layer->run = global_sumpool_run;
 		layer->build = global_pooling_build;
 	}
 
@@ -87,26 +88,69 @@ nnom_status_t global_pooling_build(nnom_layer_t *layer)
 	nnom_shape_data_t dim[1] = { layer->in->tensor->dim[layer->in->tensor->num_dim-1]};
 	tensor_set_attribuites(layer->out->tensor, qfmt, 1, dim);
 
-	// different from other *_build(), the kernel..padding left by layer API needs to be set in here
-	// due to the *_run() methods of global pooling are using the normall pooling's.
-	// fill in the parameters left by layer APIs (GlobalAvgPool and MaxAvgPool)
+	// the kernel covers the whole map. the runners below do not use these, they are kept
+	// for the layer information only
 	cl->kernel = shape(layer->in->tensor->dim[0], layer->in->tensor->dim[1], layer->in->tensor->dim[2]);
 	cl->stride = shape(1, 1, 1);
 	cl->pad = shape(0, 0, 0);
 	cl->padding_type = PADDING_VALID;
 
-	// additionally avg pooling require computational buffer, which is  2*dim_im_out*ch_im_in
-	if (layer->type == NNOM_AVGPOOL || layer->type == NNOM_GLOBAL_AVGPOOL)
-	{
-		//  bufferA size:  2*dim_im_out*ch_im_in
-		uint32_t size = layer->out->tensor->dim[0] > layer->out->tensor->dim[1] ?
-							layer->out->tensor->dim[0] : layer->out->tensor->dim[1];
-		layer->comp->shape = shape(2 * size * layer->in->tensor->dim[2], 1, 1);
-	}
-	
-	// additionally sumpool
-	if (layer->type == NNOM_SUMPOOL || layer->type == NNOM_GLOBAL_SUMPOOL)
-		layer->comp->shape = shape(4 * tensor_size(layer->out->tensor), 1, 1);
+	// avg and sum pooling accumulate in q31 per channel, plus q15 partial sums
+	if (layer->type == NNOM_GLOBAL_AVGPOOL || layer->type == NNOM_GLOBAL_SUMPOOL)
+		layer->comp->shape = shape(6 * layer->in->tensor->dim[2], 1, 1);
+
+	return NN_SUCCESS;
+}
+
+// the output tensor of global pooling has a single dimension, the channels.
+nnom_status_t global_maxpool_run(nnom_layer_t *layer)
+{
+	nnom_tensor_t *in = layer->in->tensor;
+
+#ifdef NNOM_USING_CHW
+	local_global_maxpool_q7_CHW(
+#else
+	local_global_maxpool_q7_HWC(
+#endif
+			in->p_data,
+			in->dim[1], in->dim[0], in->dim[2],
+			layer->out->tensor->p_data);
+
+	return NN_SUCCESS;
+}
+
+nnom_status_t global_avgpool_run(nnom_layer_t *layer)
+{
+	nnom_avgpool_layer_t *cl = (nnom_avgpool_layer_t *)(layer);
+	nnom_tensor_t *in = layer->in->tensor;
+
+#ifdef NNOM_USING_CHW
+	local_global_avepool_q7_CHW(
+#else
+	local_global_avepool_q7_HWC(
+#endif
+			in->p_data,
+			in->dim[1], in->dim[0], in->dim[2],
+			cl->output_shift,
+			layer->comp->mem->blk,
+			layer->out->tensor->p_data);
+
+	return NN_SUCCESS;
+}
+
+nnom_status_t global_sumpool_run(nnom_layer_t *layer)
+{
+	nnom_tensor_t *in = layer->in->tensor;
+
+#ifdef NNOM_USING_CHW
+	local_global_sumpool_q7_CHW(
+#else
+	local_global_sumpool_q7_HWC(
+#endif
+			in->p_data,
+			in->dim[1], in->dim[0], in->dim[2],
+			layer->comp->mem->blk,
+			layer->out->tensor->p_data);
 
 	return NN_SUCCESS;
 }
@@ -121,6 +121,20 @@ nnom_status_t maxpool_run(nnom_layer_t *layer)
 			layer->out->mem->blk);
 #else //end of CHW
 	// HWC
+	// 1D along W (H = 1) or along H (W = 1), the pixels are in a row either way
+	bool along_w = layer->in->tensor->dim[0] == 1 && cl->kernel.h == 1;
+	if (along_w || (layer->in->tensor->dim[1] == 1 && cl->kernel.w == 1))
+	{
+		local_maxpool_1D_HWC_q7(layer->in->tensor->p_data,
+				layer->in->tensor->dim[0] * layer->in->tensor->dim[1], layer->in->tensor->dim[2],
+				along_w ? cl->kernel.w : cl->kernel.h,
+				along_w ? cl->pad.w : cl->pad.h,
+				along_w ? cl->stride.w : cl->stride.h,
+				layer->out->tensor->dim[0] * layer->out->tensor->dim[1],
+				layer->out->tensor->p_data);
+		return NN_SUCCESS;
+	}
+
 	#ifdef NNOM_USING_CMSIS_NN
 	// 2D, square
 	if (layer->in->tensor->dim[1] == layer->in->tensor->dim[0] &&
@@ -30,6 +30,9 @@ nnom_layer_t *SumPool(nnom_shape_t k, nnom_shape_t s, nnom_padding_t pad_type)
 		layer->type = NNOM_SUMPOOL;
 		layer->run = sumpool_run;
 		layer->build = sumpooling_build;
+		// the sums are computed twice instead of buffered, see sumpooling_build().
+		// An empty buffer would still take a block, and a block of size 0 ends the memory plan
+		layer->comp = NULL;
 	}
 	return (nnom_layer_t *)layer;
 }
@@ -40,9 +43,7 @@ nnom_status_t sumpooling_build(nnom_layer_t *layer)
 	// avg pooling share the same output shape, stride, padding setting.
 	maxpooling_build(layer);
 
-	// however, avg pooling require a computational buffer.
-	layer->comp->shape = shape(4 * tensor_size(layer->out->tensor), 1, 1);
-
+	// the sums are computed twice instead of buffered, SumPool() has no computational buffer.
 	return NN_SUCCESS;
 }
 
@@ -63,7 +64,7 @@ nnom_status_t sumpool_run(nnom_layer_t *layer)
 			cl->pad.w, cl->pad.h,
 			cl->stride.w, cl->stride.h,
 			layer->out->tensor->dim[1], layer->out->tensor->dim[0],
-			layer->comp->mem->blk,
+			NULL,
 			layer->out->mem->blk);
 
 	return NN_SUCCESS;
@@ -71,6 +71,10 @@ nnom_status_t upsample_build(nnom_layer_t *layer)
 	layer->out->tensor->dim[0] = layer->in->tensor->dim[0] * cl->kernel.h;
 	layer->out->tensor->dim[1] = layer->in->tensor->dim[1] * cl->kernel.w;
 
+	// the Conv2D next up samples our input by itself, no output to make
+	cl->fused = conv2d_fuse_input(layer);
+	if (cl->fused != NULL)
+		layer->out->type = LAYER_BUF_NULL;
 	return NN_SUCCESS;
 }
 
@@ -78,6 +82,10 @@ nnom_status_t upsample_build(nnom_layer_t *layer)
 nnom_status_t upsample_run(nnom_layer_t *layer)
 {
 	nnom_upsample_layer_t *cl = (nnom_upsample_layer_t *)(layer);
+
+	// done by the Conv2D
+	if (cl->fused != NULL)
+		return NN_SUCCESS;
 #ifdef NNOM_USING_CHW
 	local_up_sampling_q7_CHW(				
 #else
@@ -71,12 +71,21 @@ nnom_status_t zero_padding_build(nnom_layer_t* layer)
 	layer->out->tensor->dim[1] = layer->in->tensor->dim[1] + cl->pad.left + cl->pad.right;
 	layer->out->tensor->dim[0] = layer->in->tensor->dim[0] + cl->pad.top + cl->pad.bottom;
 	layer->out->tensor->dim[2] = layer->in->tensor->dim[2];
+
+	// the Conv2D next pads our input by itself, no output to make
+	cl->fused = conv2d_fuse_input(layer);
+	if (cl->fused != NULL)
+		layer->out->type = LAYER_BUF_NULL;
 	return NN_SUCCESS;
 }
 
 nnom_status_t zero_padding_run(nnom_layer_t * layer)
 {
 	nnom_zero_padding_layer_t *cl = (nnom_zero_padding_layer_t*)layer;
+
+	// done by the Conv2D
+	if (cl->fused != NULL)
+		return NN_SUCCESS;
 	
 #ifdef NNOM_USING_CHW
 	local_zero_padding_CHW_q7(
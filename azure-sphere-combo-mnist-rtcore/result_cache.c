@@ -0,0 +1,142 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "result_cache.h"
+
+#define PRIME32_1	0x9E3779B1U
+#define PRIME32_2	0x85EBCA77U
+#define PRIME32_3	0xC2B2AE3DU
+#define PRIME32_4	0x27D4EB2FU
+#define PRIME32_5	0x165667B1U
+
+#define SEED		0
+
+typedef struct {
+	uint32_t key;
+	uint32_t lastUse;	// 0 = empty slot
+	int8_t outputs[RESULT_CACHE_OUTPUTS];
+} ResultCacheEntry_t;
+
+static ResultCacheEntry_t s_entries[RESULT_CACHE_ENTRIES];
+static uint32_t s_useCount;
+static ResultCacheStats_t s_stats;
+
+static inline uint32_t _rotl(uint32_t x, uint32_t r)
+{
+	return (x << r) | (x >> (32 - r));
+}
+
+static inline uint32_t _read32(const uint8_t* p)
+{
+	uint32_t v;
+
+	// input is not necessarily aligned, the compiler turns this into a single load on the M4
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static inline uint32_t _round(uint32_t acc, uint32_t input)
+{
+	acc += input * PRIME32_2;
+	acc = _rotl(acc, 13);
+	return acc * PRIME32_1;
+}
+
+// xxHash32, as specified at https://github.com/Cyan4973/xxHash
+uint32_t result_cache_hash(const void* p_data, uint32_t len)
+{
+	const uint8_t* p = (const uint8_t*)p_data;
+	const uint8_t* p_end = p + len;
+	uint32_t h;
+
+	if (len >= 16) {
+		const uint8_t* p_limit = p_end - 16;
+		uint32_t v1 = SEED + PRIME32_1 + PRIME32_2;
+		uint32_t v2 = SEED + PRIME32_2;
+		uint32_t v3 = SEED;
+		uint32_t v4 = SEED - PRIME32_1;
+
+		do {
+			v1 = _round(v1, _read32(p));
+			v2 = _round(v2, _read32(p + 4));
+			v3 = _round(v3, _read32(p + 8));
+			v4 = _round(v4, _read32(p + 12));
+			p += 16;
+		} while (p <= p_limit);
+
+		h = _rotl(v1, 1) + _rotl(v2, 7) + _rotl(v3, 12) + _rotl(v4, 18);
+	} else {
+		h = SEED + PRIME32_5;
+	}
+
+	h += len;
+
+	while (p + 4 <= p_end) {
+		h += _read32(p) * PRIME32_3;
+		h = _rotl(h, 17) * PRIME32_4;
+		p += 4;
+	}
+
+	while (p < p_end) {
+		h += (*p) * PRIME32_5;
+		h = _rotl(h, 11) * PRIME32_1;
+		p++;
+	}
+
+	h ^= h >> 15;
+	h *= PRIME32_2;
+	h ^= h >> 13;
+	h *= PRIME32_3;
+	h ^= h >> 16;
+
+	return h;
+}
+
+bool result_cache_lookup(uint32_t key, int8_t* p_outputs)
+{
+	for (uint32_t i = 0; i < RESULT_CACHE_ENTRIES; i++) {
+		ResultCacheEntry_t* e = &s_entries[i];
+
+		if ((e->lastUse != 0) && (e->key == key)) {
+			e->lastUse = ++s_useCount;
+			memcpy(p_outputs, e->outputs, RESULT_CACHE_OUTPUTS);
+			s_stats.hits++;
+			return true;
+		}
+	}
+
+	s_stats.misses++;
+	return false;
+}
+
+void result_cache_insert(uint32_t key, const int8_t* p_outputs)
+{
+	ResultCacheEntry_t* victim = &s_entries[0];
+
+	// an empty slot has lastUse 0 and always wins
+	for (uint32_t i = 1; i < RESULT_CACHE_ENTRIES; i++) {
+		if (s_entries[i].lastUse < victim->lastUse) {
+			victim = &s_entries[i];
+		}
+	}
+
+	if (victim->lastUse != 0) {
+		s_stats.evictions++;
+	}
+
+	victim->key = key;
+	victim->lastUse = ++s_useCount;
+	memcpy(victim->outputs, p_outputs, RESULT_CACHE_OUTPUTS);
+}
+
+void result_cache_clear(void)
+{
+	memset(s_entries, 0, sizeof(s_entries));
+	s_useCount = 0;
+}
+
+const ResultCacheStats_t* result_cache_stats(void)
+{
+	return &s_stats;
+}
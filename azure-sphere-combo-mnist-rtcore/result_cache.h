@@ -0,0 +1,31 @@
+#ifndef __RESULT_CACHE_H
+#define __RESULT_CACHE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Remembers the model output of recent inputs, so a repeated image (a retry, a replayed
+// drawing, a snapshot which did not change) is answered without running the model.
+// Entries are keyed on the xxHash32 of the input only, with 16 entries the chance of two
+// different images sharing a key is about 16 / 2^32.
+#define RESULT_CACHE_ENTRIES	16
+#define RESULT_CACHE_OUTPUTS	10
+
+typedef struct {
+	uint32_t hits;
+	uint32_t misses;
+	uint32_t evictions;
+} ResultCacheStats_t;
+
+uint32_t result_cache_hash(const void* p_data, uint32_t len);
+
+// on a hit the stored model output is copied out, everything else is derived from it
+bool result_cache_lookup(uint32_t key, int8_t* p_outputs);
+
+// replaces the least recently used entry when the cache is full
+void result_cache_insert(uint32_t key, const int8_t* p_outputs);
+
+void result_cache_clear(void);
+const ResultCacheStats_t* result_cache_stats(void);
+
+#endif
@@ -11,6 +11,8 @@
 
 #define CONV2D_2_KERNEL_0_SHIFT (8)
 
+#define CONV2D_2_KERNEL_0_WINOGRAD {0, -84, 76, 12, -72, 48, 92, 80, -96, 0, -196, -116, 42, -288, -6, 142, -82, 162, -30, -14, -12, 14, -192, -272, 50, -80, -18, 106, 22, 46, 70, 90, 20, 170, -92, -120, 92, -284, -100, 236, 12, 160, -52, -4, 104, 184, -88, -276, 124, 8, 26, -12, -88, 100, -76, 150, -68, -48, -32, -120, 87, -128, 5, 54, -149, 19, -128, 25, -66, 51, -42, -160, 67, 26, 79, -28, 31, 7, -100, 95, -94, 27, 42, -156, 30, -110, 58, 38, -30, -74, -152, -30, -92, 126, 32, -196, -60, -24, 138, -36, 28, -104, 116, 58, -8, -44, -60, -108, 27, -6, 51, 0, -33, -27, 2, -117, -16, 41, -78, -154, 39, -52, 5, -42, 111, -79, 34, 69, 16, 85, -30, -106, 126, -34, -82, -6, 50, -2, -80, -106, 8, 170, -48, -152, 64, 68, 88, -60, 12, -52, -52, 128, 20, -92, 104, -112, 72, 154, 62, -88, -100, -170, -96, -78, -70, 78, 72, -42, 56, 54, 102, -176, 120, -118, -136, 74, -98, -58, 104, -142, 64, 140, 76, -204, 8, -236, -180, -132, -188, 112, 72, -72, -48, -180, -112, -8, -32, -72, 140, 12, 84, 72, 48, -84, 20, -170, 82, -256, -52, -78, -74, -232, 14, 36, 102, 48, -56, -46, -10, -4, -16, 66, -42, -12, -22, 104, -82, -40, 12, -36, 184, -252, -36, 60, -256, -256, -92, 68, -28, 92, 60, -52, 18, 2, -182, -92, 24, 42, 90, 186, 126, -178, 102, 8, 179, -267, -94, -53, -127, -323, -1, 44, 38, 38, -70, -54, -1, 53, 28, 69, -127, 89, -63, 72, -104, -106, -28, 6, 160, -216, 116, 108, -278, -276, -154, -70, -192, 110, -36, 72, -54, -18, -2, -148, 148, 6, 38, -86, -94, -26, -30, -40, 7, -5, 66, -19, 69, 1, -55, -174, -132, -16, -54, 66, 3, 35, -64, -9, 5, 49, 15, 10, -74, -68, -48, -46, 64, 48, 4, 120, -74, 44, -78, -78, -112, -58, 72, 200, 76, -8, -152, -168, 32, 36, 44, 28, -16, -120, 52, 138, 104, -16, 24, 6, 16, -90, -70, -166, -196, -26, -68, 58, 12, 92, -20, -6, -80, 150, -26, -22, -96, -134, -88, -4, 40, 84, 156, 168, -96, 24, -140, -216, -276, -40, -64, -56, -16, 64, 24, -128, 192, -136, 0, -108, 128, -128, -96, 40, 222, -160, 38, -336, 262, -86, -50, -26, 58, -4, -68, 28, 6, -24, -58, -8, 142, -2, -2, -66, -22, -196, -100, 124, 244, -248, -44, -216, 212, 48, -52, 16, -92, -72, -144, 66, -92, 248, 150, -80, -110, 124, -142, 52, 56, -34, -150, -31, -31, 215, 111, -160, 13, 135, -146, 4, 67, -15, -142, 79, -35, 19, 47, -64, -31, 43, -112, 80, -5, -107, -148, -18, 26, -14, 8, -144, 92, 54, -116, 32, 6, -88, 108, -6, -16, 80, 10, -40, 122, -40, 138, 108, 80, 18, 50, 49, 109, 39, 127, -160, -17, 71, 80, 148, 87, 227, -2, -13, -11, 91, -65, 28, 155, 35, 110, -4, 43, -77, -60, 42, 114, 50, 52, -92, 16, 146, 52, 36, 50, 132, 28, 116, -92, 264, 136, 8, -180, 220, -4, 268, 8, 112, -4, -22, -144, 414, 200, 16, -266, 292, -16, 178, 96, 216, -76, 38, -52, 134, 40, -28, -18, 80, 0, 142, 60, 12, -108, -100, -104, 284, 104, -20, -104, 152, -12, 52, 148, 116, -148, -108, -12, -64, -180, -80, 44, 76, -8, -284, -108, -60, 100, -214, -64, 170, -40, 154, -76, 44, 32, -60, 72, -260, -68, -46, 68, 94, -52, -42, 28, 44, 72, -80, 68, -24, 180, -152, 16, 328, 88, 192, -92, 12, 112, 144, 248, -224, 116, -112, -40, 64, -60, 118, -118, -64, 112, -256, -34, -124, 168, -84, 95, 214, 19, 242, -238, 42, 79, -99, 73, -257, 66, 28, 69, 78, -55, 96, 12, -66, 99, -131, 21, -11, 118, 56, 204, 228, 24, 220, -108, 40, 66, 26, 128, -144, -52, -56, -48, -48, -108, -30, 46, 48, -88, -56, -66, -12, 28, -152, -105, -8, -19, 44, 6, 88, -117, -51, -5, 25, -2, 4, 29, 36, -29, 2, 52, 68, 27, -39, -77, 11, 78, -92, -28, 76, 60, 76, 12, 108, -2, -34, -16, 48, 212, -60, -76, 80, 12, 168, -116, -92, 32, -28, 8, -76, 96, -22, 54, 36, 40, 132, -156, 86, -70, -90, -4, 28, 132, 78, 30, 20, -32, 140, 36, -42, 54, -90, -124, 24, 16, 116, 160, -24, -4, 104, -4, 136, -48, -152, -136, 128, -48, -144, -72, -124, -176, -160, 60, 136, 8, -152, 56, -72, -18, 14, 156, -230, 0, -232, 278, -48, -6, -60, 18, 42, 122, -102, 4, -166, 56, -88, 70, 172, 58, 28, 10, 90, 152, 56, 232, -272, 232, -160, 288, -12, 44, 120, -28, 204, -16, -130, -108, 64, -98, 52, 30, 164, -74, -144, -74, -232, 61, -58, 85, -230, -57, -151, 250, -92, 62, 40, 111, -154, 129, -64, 123, -24, 197, 27, 104, 178, 154, -24, 39, 92, 206, 8, 316, -318, 238, -176, 324, -78, 290, 160, 224, 170, -44, 34, 8, 64, -70, -52, 26, 144, 54, -32, 118, 0, -5, 136, 103, 32, 21, 15, 62, 58, 36, 36, 51, 66, -21, -26, 41, -34, 27, 17, 36, 92, 92, 0, 79, 64, 18, 76, 136, -66, 118, 84, 72, 6, 74, 68, 12, 130, -12, 48, -28, 252, 8, 160, -4, 172, -28, -24, -12, -160, 74, 64, 32, 32, -36, 96, 34, 14, 104, 136, 144, -130, -14, 12, 160, 108, 168, 132, 70, 98, 188, -52, 108, 66, 72, 28, 220, -112, 124, 68, 108, -60, 320, 108, 264, 96, 84, -8, -32, 68, 68, 32, -212, -52, 236, 128, -20, 100, 164, 106, 60, 80, -98, 74, 90, 28, 100, 196, 152, 56, -48, 74, 48, -12, -26, 38, -22, -64, 100, 20, 20, 144, 32, 188, 140, 0, -192, 80, 280, 16, -36, 88, 192, 100, 42, 74, -22, -218, -44, 120, -182, -228, 126, -106, -114, 38, 76, 50, -75, 16, -171, 241, -105, -119, 91, -51, 1, -144, -56, 64, 79, -68, -123, 5, -107, -69, 49, -23, -71, 36, -22, 40, 26, 166, -250, 126, -30, 40, 14, 32, 44, -146, 182, -102, 62, 62, -104, 128, -62, -104, 170, 30, -102, 90, 292, -144, -67, 242, -133, 247, -19, 135, 215, 255, 91, 74, -80, -6, 91, -10, -61, 15, -29, -19, 105, 51, -37, 186, 30, -48, -38, 170, -90, 134, 14, 220, 150, 276, 156, 170, 140, -20, 72, -224, -216, 216, -32, -280, 60, -204, -196, 28, 204, -200, -202, 178, -206, 414, -214, -12, 206, 8, -60, -126, -88, -16, 122, -66, -158, -18, -114, -24, 54, 8, -128, 78, -24, -196, -152, 336, -148, 180, -296, 244, 200, 220, 8, -76, -136, 120, -108, -4, -108, -4, 136, 188, -164, -48, -184, -92, -200, 76, 6, -142, -182, -124, 244, -108, -158, -194, -146, -178, 0, 112, -38, -86, 10, -36, 192, 68, -46, -10, -138, 18, -64, 68, 76, -224, -64, -156, 300, -228, -40, -156, -100, -68, -166, 128, -30, 174, -36, 4, 82, 164, -182, 22, -138, 60, -183, 41, -38, 59, -33, -100, 13, 117, -124, -6, -79, 59, -99, 97, -80, 135, 31, 82, 153, 45, -84, 0, -87, 111, -116, 10, -88, 20, 34, -22, 84, -2, -26, -28, -28, 110, -18, 160, 74, -114, -104, 16, 226, 48, 14, -166, -30, -100, -43, 151, 170, -151, -23, 10, 339, -133, -46, -128, -49, -27, -11, 43, 56, -35, 13, 48, 143, 103, 30, -98, 51, -11, -36, 34, 152, -72, 94, 42, 256, -78, -30, -60, 32, 62, -48, 168, 152, 64, -32, 24, 172, 24, -4, -96, 16, 52, -26, 116, 126, 50, 126, 34, 108, 92, -12, 60, 18, 210, -110, 28, 14, 186, 34, 166, 104, 80, -8, -88, 102, 82, -88, -24, -12, 172, 192, 176, 40, 148, -16, 68, 104, 240, -76, 188, 196, -56, 232, -252, -284, 36, -24, -136, 8, 224, 12, 60, -28, 22, 204, -100, -148, 34, 72, -144, -10, 34, 24, 124, -4, 58, 104, -184, -124, -50, 116, 4, 50, 54, 112, -4, -228, 136, 76, -32, 12, -52, 212, -4, 32, -136, -274, 186, 164, -236, 240, -512, -152, -130, -148, -24, -48, 278, -179, 102, 25, -32, 181, -299, -133, 52, -3, -29, -24, 129, -89, 164, 53, -56, 21, -223, -25, -86, -47, 31, 82, 125, 6, 80, -86, 148, -38, -10, -6, 96, 98, 26, 106, -24, 74, 94, 216, 20, -8, -32, -180, 22, 116, -12, 108, 194, 37, 42, 39, 86, 23, 93, -7, -2, 105, -41, 2, 73, 91, 112, 159, 110, 47, -55, -91, 32, 81, 43, 96, 61, 54, 60, -18, 176, 78, 70, 82, 8, 70, 14, -10, -60, -124, 92, 184, -160, 0, -292, -48, -144, -8, 100, 52, 248, -154, 84, 92, 32, 0, -106, 8, 16, 30, 74, -12, 168, -22, 152, 216, -4, -36, -94, 8, -4, -82, 70, 128, 132, -52, 144, 124, 188, -36, 92, 64, 156, -44, 44, 64, 52, -140, -128, -212, 28, -220, 80, 44, -44, 32, -116, -168, -176, -122, -56, -136, -54, -28, -14, 30, -144, 38, -50, -80, -56, -42, 20, 16, 10, -84, -78, -102, -56, 74, -182, -96, -88, -24, 92, 92, -72, 108, -172, -116, -156, 80, -116, -8, 32, 24, -10, -170, 126, -120, 150, -44, 16, 142, 14, -34, -122, -10, 100, 5, 30, -135, 15, -149, -104, 115, 4, -68, -40, -78, 44, -95, -46, -73, -3, -113, -44, 41, -168, -94, -14, -112, 154, 80, -142, -88, -138, -218, -164, 14, -178, -128, 68, 32, -34, -26, -14, -240, 158, 116, 0, 30, -38, -30, -30, -100, -14, -5, -96, -59, 83, 41, -52, -37, -76, -44, -62, 48, 26, 35, 32, -77, -19, -15, 8, 73, -92, -122, -64, -84, 46, 56, -50, 104, -94, -90, -44, 6, -130, -136, -96, 196, 84, 16, 84, -140, 228, 28, 60, 140, 92, 104, 24, 12, 142, 136, -12, -166, 112, -138, -12, 40, -22, -32, -46, 12, 50, -76, -24, -66, 56, -26, 20, 40, -78, -120, 10, -172, 108, 44, -120, -92, -60, -192, -52, -60, -192, -256, -60, 48, -28, 8, -96, 252, -28, -120, -28, -12, -72, 20, -100, -102, -90, -108, -40, 244, -4, -214, 146, -54, -136, 18, -58, 42, -30, 76, -12, 124, 96, 26, -58, 62, -148, 46, 6, -108, -92, -40, 44, 116, 120, -68, 116, 20, -212, 44, 48, 80, 10, 54, 4, 184, -168, 64, -94, -146, -24, -44, 84, -211, -38, -20, -46, 107, -118, -15, -15, -235, 45, -46, 151, 139, -6, 96, 64, 131, -80, -3, -85, -63, 19, 22, 105, -152, -54, 22, 14, 54, -30, -82, -6, -152, 88, 20, 172, 24, 6, 38, -116, 36, -112, 12, -138, 18, -164, -24, -48, -19, 22, 40, -168, -63, -44, 41, -211, -15, -247, -58, -117, 3, -42, 96, -50, 17, 10, 25, -65, 45, -85, 122, 17, -40, -26, 98, -102, -82, 78, 54, -138, 12, -168, 88, -52, 56, 44, 84, -16, -32, -252, 196, -204, -116, -116, -88, 136, -128, 74, 128, -174, -200, -158, 240, -372, -196, -66, -122, 92, 100, -18, 116, 26, 24, -166, -4, -92, -80, 82, 98, 116, -84, 12, 160, -132, -144, -72, 40, -260, -160, 132, 64, 72, -4, 28, 156, -104, -140, -76, 104, -208, -120, -108, -116, 188, 52, 0, -8, -44, -156, -106, 74, -166, -32, -122, -18, -14, -44, -60, 88, -144, -72, -66, -74, -150, -12, -114, 34, 42, 12, -88, -76, -84, -88, -96, -104, -108, 76, -128, 132, -160, -62, -62, 24, -72, -22, -84, 4, -184, -4, -66, -106, 102, -44, -67, 3, 20, -92, -57, 56, -135, -62, -187, -63, -48, 38, -145, 43, -72, 10, -61, 12, -191, 42, -55, 17, 62, 56, -150, 22, 20, -60, -34, 64, -142, -16, -176, 60, -88, -74, 38, 60, -20, -70, 16, 52, -108, -136, -62, -90, 122, 28, 11, -25, 6, -134, -5, 52, -105, -62, -47, -85, 42, -30, 1, 91, -122, -104, -45, -64, -45, -30, -59, 11, 124, 72, -26, 6, -96, -168, -66, -64, -42, 44, -44, 16, 44, -132, -52, -72, 12, 48, 8, -48, -84, -20, -20, -80, 36, -68, -56, -14, 70, -70, 44, 34, -74, -92, -112, -130, 8, 52, -84, 46, -50, -22, -40, 22, -86, 24, 0, -6, 144, 116, -88, 104, 8, -140, -4, 104, -76, -48, -92, -56, 116, 144, 92, -12, -28, 356, -180, -20, 240, 156, 80, -8, 172, 274, 26, -110, 122, 96, -74, -118, 138, 150, -16, -84, -10, 190, -134, 34, 30, 128, 42, 110, 66, 322, -12, 80, 6, 320, -200, -64, 180, -132, 148, 12, -36, 316, -108, 4, -176, 166, 76, 102, -232, 206, -264, 132, -42, 228, -2, 118, 6, 87, 54, -15, 26, 194, -281, -74, 37, 84, 25, 23, 14, 335, -130, 17, -8, -92, 81, 124, -29, 340, -9, 307, -220, 256, -152, -100, 250, -104, 64, -82, 50, 196, 18, 212, -212, -22, 0, 18, 124, 10, 72, -152, 110, -8, 146, 22, 78, 95, 44, 23, 118, 20, -3, -94, -29, 22, -23, -1, 24, -33, -92, 59, 72, 90, -13, -88, 117, 66, 19, -1, 42, 84, -48, 64, 66, 100, -88, -30, -22, 96, -150, -24, -12, 0, -16, 132, -80, -140, -12, 0, -172, 64, 64, 148, -88, -92, 72, 118, 22, 118, -210, -50, -130, -44, 18, 106, 48, 112, -88, 42, 34, -130, 26, -74, 22, 84, 22, 226, -184, 20, 0, 28, 136, 128, -172, -124, 64, -24, -24, 184, -48, 148, -12, -212, -36, 176, 120, 232, -84, 264, -60, 80, -148, -26, 112, -180, -94, 146, 88, 144, -34, 10, -140, -26, -8, 2, -56, -212, 2, 22, 112, 92, -6, 82, -188, -10, -48, -172, 68, -180, -56, -8, 80, 4, 44, -172, -268, -116, 92, 280, 20, -16, -102, -30, 66, 198, -136, 392, 4, 74, -276, 118, 131, -75, -166, 142, 12, 41, -84, 157, -116, -23, -16, 88, -63, -219, -2, -16, 144, -31, 60, 203, -144, -7, -146, -74, 48, -278, -66, 156, 90, -188, 112, -32, -264, -104, 114, 48, 44, -112, -114, 134, -6, 94, -108, 52, -44, 46, 16, -68, 67, -75, -68, 148, -118, 69, 60, -97, -68, 59, 94, -74, -11, -119, 20, 38, 34, -11, -32, -67, -56, 15, 24, -190, 12, -82, 66, 52, -78, -36, 136, -216, -80, 28, 102, 180, 76, 84, -180, -72, -60, 60, -160, 180, 20, 40, -112, 76, 86, 30, -140, 144, -194, -34, 10, 50, -44, 62, 86, 12, -18, -126, 16, 0, 66, -134, 34, 54, -12, 18, -74, -92, -8, -180, 56, 216, -68, -228, 204, -76, -76, 40, 124, 100, 148, 132, 76, 16, -4, 308, 88, 236, 232, 292, 16, 80, 222, 146, -222, -28, 180, 134, -134, 288, -40, 58, -18, 68, -58, -6, 130, 88, 100, 154, 34, 108, 32, 86, -46, 48, 16, 8, -168, 44, 284, -20, -188, 160, -240, -148, -80, -40, 90, 90, 56, -64, 42, 128, -38, 88, 100, 280, -104, 150, 24, -17, -244, -130, 241, 43, -304, 251, -77, 86, -234, 58, -166, 37, 208, 0, 111, 239, 124, 169, 137, 308, -166, 248, -232, -70, -92, -66, 310, 154, -142, 332, -40, 114, -296, 116, 30, -26, 32, -120, -26, 188, -142, 32, -52, 32, -56, -2, 78, 45, -114, -160, -53, 129, -232, -7, -151, -46, -74, 70, -4, 27, -74, -38, -43, 93, -204, -37, -89, -36, -26, -48, 44, 98, -220, -78, -70, 34, -294, -76, -188, -114, -44, -24, -28, -68, 12, -200, 20, 8, -268, -116, -184, 20, -176, 68, -120, -118, -136, -262, 8, 38, -402, -44, -188, -18, -290, 60, -112, 70, 4, -126, -32, 178, -114, 24, 16, 186, -146, 152, -204, 20, -144, -188, -44, 208, -248, 96, 12, 148, -260, -72, 132, 72, -156, -172, 52, -44, -256, -192, -124, -64, -96, 38, -84, 28, -90, -250, 72, -72, -188, 16, 40, 64, -54, 50, 64, 124, -18, -130, -64, 36, -260, -12, 68, 20, -78, 160, -152, 80, 48, -208, -44, 8, -192, 196, 232, 148, -36, -162, -118, -126, -184, -112, 92, -32, -248, -96, -84, -152, -278, 24, -141, 19, -138, -186, 86, -31, -188, 18, 63, 62, -281, -50, 69, -53, -122, -70, -36, -107, -272, 24, 59, -48, -95, 136, 46, 92, -76, -144, -42, -106, -212, 138, 206, 166, -98, -46, 86, 78, -136, -184, 12, 80, -160, -172, 4, -12, -74, -12, -39, 35, -92, -186, 30, 43, -154, 28, 65, 68, 3, 38, 59, 67, -96, -146, -20, 15, -174, -30, 13, -38, -39, 72, -66, 24, -52, -148, -2, -22, -168, 170, 74, 42, 38, -136, -164, -120, -164, -124, 52, 92, -152, -76, 44, -100, -256, -26, -96, 26, -140, -122, 44, 84, -154, 30, 88, 66, -224, -62, 64, -110, -200, -86, 8, -128, -186, 6, 4, -106, -56, 48, 132, 36, -176, -84, 0, -136, -188, 112, 48, 60, -24, -152, 48, -52, 60, 232, -316, 144, 124, 72, 28, -60, 128, -34, 2, -240, 262, 270, -180, -146, 340, 8, 116, -10, 198, -66, 106, -12, 106, 54, -12, 34, 164, 52, -12, 18, 2, 52, 60, -200, 308, 92, 124, -256, 380, -12, 76, 68, 72, -194, -14, -34, 166, -76, -106, 238, 200, 28, -96, -64, 8, -157, -23, -53, 225, -38, -118, 62, 224, -60, -26, -29, 42, -79, 37, 9, 145, -98, 12, 100, 102, 4, 36, 65, -94, -42, 28, -10, 204, -60, 0, -76, 126, -84, 106, 100, -60, -86, 2, 38, -50, 44, -78, -30, -76, 148, -36, -16, -8, 5, -47, -127, 95, 16, 50, -222, 52, 170, -78, 9, -58, -21, -55, 51, 39, 40, -24, 20, 50, 142, -8, -33, -46, 70, -104, -114, 184, 12, 104, -172, 178, 164, -50, -8, -96, -128, -60, 56, 56, -264, 132, 64, 0, 104, -160, -20, -128, -118, -72, 60, 58, -292, 112, -14, -64, 102, -220, -10, -214, -34, -124, 72, 78, -112, 0, 86, -12, 94, 40, 14, -142, -24, -136, 76, 80, -140, -20, 8, -76, 92, -20, 24, -228, -28, -28, 12, -228, -52, 140, -140, -192, 96, 0, -68, 4, 158, -18, -90, 82, -120, 364, -162, 10, 144, -8, 46, -52, -98, -18, 58, -198, -68, 84, -90, -162, 36, 16, -82, 92, 88, -8, -44, 112, -136, 308, -112, 40, 84, 8, 32, 36, 12, 130, 40, 16, 8, 56, -78, 2, 156, -48, -4, -44, 111, 49, 19, 122, -45, 153, 3, 35, 81, -223, 116, -81, -45, 55, -3, -18, -31, -31, 45, 23, -51, -27, -6, 9, 54, -26, -24, 88, -84, 66, 126, 56, -126, -202, 114, -28, -100, 54, 132, -236, -96, -144, 178, -82, 0, -108, -28, -4, 41, 59, -47, -94, 53, -43, 101, 57, 15, -165, -106, -37, 29, 25, -9, -106, -89, 53, 3, 13, 79, -5, 60, 73, 170, 30, -188, 36, 60, 154, -74, 152, 94, -62, -18, 40, -60, 212, 160, 8, -36, -228, 240, 112, 60, -156, 36, -52, -6, 126, 62, -54, 128, -254, 266, 82, -48, -380, -36, -66, 82, 98, -70, 74, -52, -62, 138, 198, -8, -48, 136, -10, 136, 12, -168, 12, 112, -88, 164, 168, -116, -272, 64, -24, 188, -52, -12, 172, -152, 88, 76, 168, 256, 40, 80, 108, 44, -94, 10, 176, -70, -10, -62, 136, -66, -16, -38, -34, 96, 2, -54, 92, -26, 54, -6, 184, 70, -112, -34, -18, -48, -40, -32, 96, 56, -44, -144, 152, -252, -168, -152, -160, 276, -6, 86, 96, -226, 94, -48, 14, 126, 58, -48, 74, 263, -60, 86, 222, -96, 199, -133, 69, 70, 10, -72, -133, 77, 104, 66, 24, -126, 47, -11, 95, 32, 18, -58, 49, 64, 50, 66, 150, 4, 152, -96, 150, -24, -30, -82, -158, 216, -14, -14, 244, -6, 150, 88, 122, 250, -22, 28, -38, 137, 8, 60, 200, -84, 51, -77, 131, 48, 50, -6, -67, 11, 72, 116, 54, -54, -81, 29, -27, -42, -150, -88, -41, -68, 94, 190, 10, -132, -180, -136, -18, -244, -78, -122, -70, 304, 32, 84, 168, -80, 156, -36, -32, 120, -4, -100, -72, 356, 42, 136, 246, -110, 260, -148, 64, 184, 76, -40, -166, -8, 174, 236, -14, -154, -88, 24, -116, -80, -20, -112, 26, 44, 184, 288, 64, -184, 16, -88, -20, -16, 60, -52, -68, -136, -100, -8, 156, -20, -80, -124, 88, -200, -176, -140, -88, -84, -62, -74, -38, -54, -162, 134, 84, -92, -186, 4, -146, -96, 50, 18, -18, 18, -110, -142, 40, -88, -62, -60, 26, -44, 88, -48, -212, -16, -192, 116, 36, 20, -72, 84, -32, -198, 56, 2, 204, 40, -128, 146, 192, -224, -70, -70, 184, -175, 69, -67, 7, -24, -82, 199, 152, -138, -88, 59, 72, -95, 51, 15, 39, 16, -80, 17, 0, -142, -10, -125, 82, -72, 64, -54, -158, -48, -34, 70, -40, -56, -28, 4, -30, 18, -8, 138, -52, -88, -176, 78, -132, -56, -50, -30, -84, -13, 19, -21, -63, -60, -178, 165, -54, -110, -110, -11, -50, -53, 73, 77, -71, 8, -140, -49, -42, -70, -80, 5, -76, -84, 100, -82, -82, 36, -142, 38, 36, -124, -140, 24, -42, -44, 148, 148, -4, -28, -224, 348, -28, -80, 56, 40, 188, -104, 150, -14, -18, -30, -98, 230, 14, -156, -12, 44, 168, -52, 74, 74, -14, 6, -110, 110, -82, -124, -28, -60, -20, -112, 76, -88, -28, 4, 16, -8, -40, -200, -96, -56, -40, 20, 52, -32, 72, 248, -144, 40, 80, -156, 68, -68, 292, -30, 48, 66, 128, 140, -88, 96, 296, -140, 332, 116, 254, -42, -20, -54, 28, 220, -44, 60, 40, -148, 48, 52, 94, -92, -24, 44, 84, 112, 12, 116, 256, -132, 312, 236, 56, -10, -86, -20, 34, 172, -76, 172, 120, -144, -88, -150, -10, -79, -107, 85, 106, 75, -46, 210, 177, -267, -14, -23, -132, -3, -11, -29, -42, 151, 44, 96, -3, -25, -38, 71, -60, -72, -32, 76, 30, 54, 74, 134, 54, -148, 36, 198, -182, 22, 38, -80, 154, 144, 12, -140, 252, -68, 36, -2, 70, 113, -139, -117, 340, 143, 176, -202, 397, 41, 166, 113, -2, -99, -23, 9, 124, 59, -10, -44, 117, -65, -42, 39, -38, -8, -200, -28, 310, 58, 154, -106, 262, 44, 88, 154, -110, -8, -100, -68, 116, 68, 80, -8, 292, -56, -120, -84, -232, 64, -294, -98, 318, 78, 218, -88, 278, -86, -180, -26, -388, -60, -14, 34, 54, -10, 78, -8, 74, 58, -128, 58, -192, 12, -208, 4, 256, 0, 216, -88, 60, 28, -188, 116, -348, -216, 188, 48, -128, -48, -104, -72, -8, -180, 112, -120, 160, -164, 96, -26, -172, -152, 76, -152, -172, -6, -86, -288, 50, -32, 52, 46, 64, -4, -12, 72, 40, -38, 14, 56, 102, 20, -40, -28, 20, -108, 168, -8, -124, 136, -184, -112, -8, -30, 210, 228, -216, 56, -80, -156, -322, -124, 134, -24, 338, -53, 75, 36, -164, 11, 30, -257, -318, 15, -36, -152, 157, -5, -11, 52, 14, 29, 50, 79, -112, -9, 50, 140, 155, -28, -146, -140, 66, -16, 160, -22, -108, 130, -120, 12, -26, -138, 62, -28, -72, 36, -172, -84, -42, -116, -10, -64, 66, -39, -25, -34, -56, -83, -20, -89, -104, -5, -30, -108, -7, -59, 65, 38, 14, 31, -24, 19, 58, 67, 24, -4, -1, 40, -22, 32, 30, -88, 128, 14, -4, 178, 4, -48, -74, 48, 84, 152, -160, 140, -148, -168, -356, -60, 12, 32, 244, 72, -46, 28, -48, 80, -66, -194, -250, 16, 20, 28, 100, -32, 2, 44, -36, 64, 38, 26, -94, 96, 60, 80, 52, -8, -128, -80, 76, 4, 120, 0, 12, 172, 68, 76, -92, -68, 140, -12, -96, 156, -208, 160, -48, -108, 36, 52, 220, -66, 184, -94, -74, 78, -126, -62, 102, -236, 116, 12, 116, 134, 60, 34, -78, 94, 102, 66, -162, 56, 68, 80, 76, 136, 104, -48, -56, 16, 184, -156, -12, -72, 148, 40, -28, -156, 62, -136, -94, -102, -80, 244, 16, -10, -68, -186, -42, -163, 150, -22, -139, 22, -104, 251, 91, -162, 39, -51, 23, 31, -8, -98, -85, -48, 46, 61, 9, 32, 27, -27, -11, 24, 80, 16, -130, 76, 22, 68, 84, -120, 134, 108, 54, -40, 38, -56, 38, -82, -36, 20, -96, -46, -152, -6, 46, 67, 18, -96, 15, -20, 6, -11, -99, -8, -53, 1, -9, 113, 64, -24, -27, 22, 64, 43, -37, -6, -97, 33, 49, 220, 44, -64, -50, 84, 106, 12, -40, 32, 2, 40, -6, -128, -40, -180, 40, -340, 92, 104, -32, 52, -256, -244, -216, -30, -16, -24, -50, -76, 28, 302, -110, 66, -130, -62, -102, 10, -4, -156, -34, -120, 8, 38, 134, -30, -138, -74, -38, 108, 20, 0, -124, 144, -56, 236, 56, -16, -12, 108, 76, 12, -16, -32, -116, 32, -48, 56, 16, 20, -68, -116, -72, -4, -92, 16, -176, -48, 28, -6, -12, 12, 22, -30, 32, -220, 44, -120, -124, -20, -184, 98, -80, -168, -94, 10, -60, -236, -32, -72, -184, -100, -108, 36, -108, -176, -4, 96, 44, 148, 96, 138, -114, 90, -28, -124, -84, 52, -34, -122, 54, 178, 40, 140, -77, 32, 18, -65, -200, 96, -109, -56, 1, -88, 8, -104, -167, 62, -84, 11, -82, -40, -81, -90, -45, -58, -48, -102, -130, 4, -38, 70, -198, 4, -156, -24, -98, -84, -12, 14, -206, 14, -96, 112, -84, -88, -86, -198, 14, -86, -118, -130, -107, -38, -26, -9, -18, -60, -83, -50, -63, -100, -50, -70, -125, -24, -92, 11, -40, 56, -23, -12, 43, -102, -156, -214, -26, -76, -22, -110, 26, 84, -20, 136, -34, 52, 100, 184, -204, 72, -76, -68, -184, -56, -52, -204, 140, 96, 14, -6, -8, 42, -36, -68, -206, 24, -214, -76, -94, 32, -86, -54, -168, 58, 8, -76, -42, 184, -10, -112, 58, 76, -172, -244, 28, 28, 48, -76, -64, 264, -172, 16, -176, -100, -20, -36, -44, -184, -108, 80, -52, -132, 36, 36, -200, 38, 10, 34, -102, -62, -84, 108, -144, 56, 92, 152, -216, -30, 70, -58, -142, 26, -68, 0, -52, -12, -108, 24, -12, 108, 100, 12, -200, 148, -44, 28, -144, 176, -52, 140, -28, -42, -168, -152, 68, -126, -166, -88, 22, 20, 106, -8, -192, 49, -4, 116, -184, -78, -273, -55, -193, 123, 126, 192, -161, -105, -14, -100, -80, 136, -67, -173, 63, -29, -74, -70, 71, -14, 150, 168, -332, 184, -174, -140, -152, 74, -54, 130, 102, -146, 108, -12, -112, -130, -118, 20, -34, -124, -26, 56, -80, -151, 82, -32, -96, 6, -133, 109, 53, -11, -8, 72, -47, -225, 152, -60, -4, 4, 5, -65, 77, -95, -96, 58, -35, -230, 126, -80, 12, 140, -10, 24, 164, 18, -78, 74, -2, -88, -40, -128, 0, -72, -176, -148, 40, 28, 44, 12, -72, -140, 68, 50, -178, -10, -322, -54, 4, 56, 26, 112, 8, -300, 68, -102, 58, 114, 6, -238, 192, -112, -62, -36, 48, -352, 176, 76, -120, 176, -140, -144, 156, -84, -80, 64, 128}
+
 #define CONV2D_2_BIAS_0 {-5, -21, -37, -32, 22, -38, 16, -103, -8, 33, 3, -50, 4, 11, 0, -18, -32, -43, -1, -19, -7, -4, -26, -15}
 
 #define CONV2D_2_BIAS_0_SHIFT (9)
@@ -112,6 +114,8 @@ static const int8_t conv2d_1_bias[] = CONV2D_1_BIAS_0;
 static const nnom_bias_t conv2d_1_b = { (const void*)conv2d_1_bias, CONV2D_1_BIAS_LSHIFT};
 static const int8_t conv2d_2_weights[] = CONV2D_2_KERNEL_0;
 static const nnom_weight_t conv2d_2_w = { (const void*)conv2d_2_weights, CONV2D_2_OUTPUT_RSHIFT};
+static const int16_t conv2d_2_winograd[] = CONV2D_2_KERNEL_0_WINOGRAD;
+static const nnom_weight_t conv2d_2_ww = { (const void*)conv2d_2_winograd, CONV2D_2_OUTPUT_RSHIFT};
 static const int8_t conv2d_2_bias[] = CONV2D_2_BIAS_0;
 static const nnom_bias_t conv2d_2_b = { (const void*)conv2d_2_bias, CONV2D_2_BIAS_LSHIFT};
 static const int8_t conv2d_3_weights[] = CONV2D_3_KERNEL_0;
@@ -141,7 +145,7 @@ static nnom_model_t* nnom_model_create(void)
 	layer[1] = model.hook(Conv2D(12, kernel(3, 3), stride(1, 1), PADDING_SAME, &conv2d_1_w, &conv2d_1_b), layer[0]);
 	layer[2] = model.active(act_relu(), layer[1]);
 	layer[3] = model.hook(MaxPool(kernel(2, 2), stride(2, 2), PADDING_SAME), layer[2]);
-	layer[4] = model.hook(Conv2D(24, kernel(3, 3), stride(1, 1), PADDING_SAME, &conv2d_2_w, &conv2d_2_b), layer[3]);
+	layer[4] = model.hook(conv2d_winograd(Conv2D(24, kernel(3, 3), stride(1, 1), PADDING_SAME, &conv2d_2_w, &conv2d_2_b), &conv2d_2_ww), layer[3]);
 	layer[5] = model.active(act_relu(), layer[4]);
 	layer[6] = model.hook(MaxPool(kernel(2, 2), stride(2, 2), PADDING_SAME), layer[5]);
 	layer[7] = model.hook(Conv2D(48, kernel(3, 3), stride(1, 1), PADDING_SAME, &conv2d_3_w, &conv2d_3_b), layer[6]);